@@ -1,6 +1,8 @@
 #pragma once
 #pragma region MISC
 #include <string>
+#include <cstdint>
+#include <cmath>
 
 struct SteeringPlugin_Output
 {
@@ -199,6 +201,28 @@ struct AgentInfo
 };
 #pragma endregion
 
+namespace ExamHash
+{
+	// Finalizer of splitmix64, every input bit affects every output bit so close inputs end up in different buckets
+	inline std::size_t Mix(uint64_t value)
+	{
+		value ^= value >> 30;
+		value *= 0xbf58476d1ce4e5b9ull;
+		value ^= value >> 27;
+		value *= 0x94d049bb133111ebull;
+		value ^= value >> 31;
+		return static_cast<std::size_t>(value);
+	}
+
+	// Houses never move, a center snapped to 1/8th of a unit identifies a house and keeps (x, y) and (y, x) apart
+	inline std::size_t HashPosition(const Elite::Vector2& position)
+	{
+		const uint32_t x{ static_cast<uint32_t>(static_cast<int32_t>(std::lround(position.x * 8.0f))) };
+		const uint32_t y{ static_cast<uint32_t>(static_cast<int32_t>(std::lround(position.y * 8.0f))) };
+		return Mix((static_cast<uint64_t>(x) << 32) | y);
+	}
+}
+
 namespace std
 {
 	template <>
@@ -206,7 +230,8 @@ namespace std
 	{
 		std::size_t operator()(const ItemInfo& item) const
 		{
-			return std::hash<int>()(item.Value);
+			// Same member as operator==
+			return ExamHash::Mix(static_cast<uint32_t>(item.ItemHash));
 		}
 	};
 
@@ -215,7 +240,7 @@ namespace std
 	{
 		std::size_t operator()(const HouseInfo& house) const
 		{
-			return std::hash<float>()(house.Center.x) + std::hash<float>()(house.Center.y);
+			return ExamHash::HashPosition(house.Center);
 		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "stdafx.h"
+#include "Aim Controller.h"
+
+namespace MovementBehavior
+{
+	AimController::AimController(float naturalFrequency, float alignedAngle) :
+		ISteeringBehavior(),
+		m_NaturalFrequency{ naturalFrequency },
+		m_AlignedAngle{ alignedAngle },
+		m_HasRequest{},
+		m_Request{}
+	{
+
+	}
+
+	SteeringPlugin_Output AimController::CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData)
+	{
+		SteeringPlugin_Output steering{};
+		steering.AutoOrient = false;
+
+		// How far we are off and how fast the target moves around us (radians per second)
+		const Elite::Vector2 direction{ targetData.position - agentInfo.Position };
+		const float error{ Elite::AngleBetween(Elite::OrientationToVector(agentInfo.Orientation), direction) };
+		const float targetRate{ direction.Cross(targetData.velocity - agentInfo.LinearVelocity) / std::max(direction.MagnitudeSquared(), FLT_MIN) };
+
+		// Spring towards the target, damped on how much faster we turn than it moves so we keep up with it instead of chasing it
+		const float acceleration{ (m_NaturalFrequency * m_NaturalFrequency * error) + (2.0f * m_NaturalFrequency * (targetRate - agentInfo.AngularVelocity)) };
+		float angularVelocity{ agentInfo.AngularVelocity + (acceleration * deltaT) };
+
+		// Never turn past the target within one frame, that is where the old flipping between left and right came from
+		const float remainingRate{ (error / std::max(deltaT, FLT_MIN)) + targetRate };
+		angularVelocity = (error > 0.0f) ? std::min(angularVelocity, remainingRate) : std::max(angularVelocity, remainingRate);
+
+		steering.AngularVelocity = std::clamp(angularVelocity, -agentInfo.MaxAngularSpeed, agentInfo.MaxAngularSpeed);
+		return steering;
+	}
+
+	bool AimController::IsAligned(const AgentInfo& agentInfo, const TargetData& targetData) const
+	{
+		return std::abs(Elite::AngleBetween(Elite::OrientationToVector(agentInfo.Orientation), targetData.position - agentInfo.Position)) <= m_AlignedAngle;
+	}
+
+	void AimController::Request(const TargetData& targetData)
+	{
+		m_Request = targetData;
+		m_HasRequest = true;
+	}
+
+	void AimController::ClearRequest()
+	{
+		m_HasRequest = false;
+	}
+
+	bool AimController::HasRequest() const
+	{
+		return m_HasRequest;
+	}
+
+	const TargetData& AimController::GetRequest() const
+	{
+		return m_Request;
+	}
+}
\ No newline at end of file
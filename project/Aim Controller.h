@@ -0,0 +1,39 @@
+#ifndef AIM_CONTROLLER
+#define AIM_CONTROLLER
+
+#include "Movement Behaviours.h"
+
+namespace MovementBehavior
+{
+	// Turns us towards a moving point like a critically damped spring, fast without swinging past it
+	// Anyone can request an aim during the tick, the plugin applies the last request on top of the steering and clears it
+	class AimController final : public ISteeringBehavior
+	{
+	public:
+		// The natural frequency sets how fast we settle (about 5 / frequency seconds for small turns), aligned is how close counts as facing it
+		AimController(float naturalFrequency = 30.0f, float alignedAngle = Elite::ToRadians(2.0f));
+		virtual ~AimController() = default;
+
+		AimController(const AimController& other) = delete;
+		AimController& operator=(const AimController& other) = delete;
+		AimController(AimController&& other) = delete;
+		AimController& operator=(AimController&& other) = delete;
+
+		// Only the angular velocity is filled in, auto orient is off
+		virtual SteeringPlugin_Output CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData) override;
+		bool IsAligned(const AgentInfo& agentInfo, const TargetData& targetData) const;
+
+		void Request(const TargetData& targetData);
+		void ClearRequest();
+		bool HasRequest() const;
+		const TargetData& GetRequest() const;
+
+	private:
+		float m_NaturalFrequency;
+		float m_AlignedAngle;
+		bool m_HasRequest;
+		TargetData m_Request;
+	};
+}
+
+#endif
\ No newline at end of file
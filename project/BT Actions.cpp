@@ -3,6 +3,11 @@
 #include "IExamInterface.h"
 #include "Blackboard.h"
 #include "Exam_HelperStructs.h"
+#include "Perception.h"
+#include "Inventory.h"
+#include "Inventory Optimizer.h"
+#include "Target Selector.h"
+#include "Aim Controller.h"
 #include <algorithm>
 
 namespace DecisionMaking
@@ -14,82 +19,51 @@ namespace DecisionMaking
 			// Will always return success since we are working with only one sequence in our tree
 			State output{ State::Success };
 
-			FOVStats fovStats{};
-			pBlackBoard->GetData("FOVStats", fovStats);
+			PerceptionFrame* pPerception{};
+			pBlackBoard->GetData("Perception", pPerception);
 
 			// Check if there are any enemies in sight
-			if (fovStats.NumEnemies > 0)
+			if (!pPerception->Enemies.empty())
 			{
-				std::vector<ItemInfo>* inventory{};
-				pBlackBoard->GetData("Inventory", inventory);
+				Memory::Inventory* pInventory{};
+				pBlackBoard->GetData("Inventory", pInventory);
 
-				auto itShotgun{ std::ranges::find_if(*inventory, [](const ItemInfo& item) -> bool { return item.Type == eItemType::SHOTGUN; }) };
-				auto itPistol{ std::ranges::find_if(*inventory, [](const ItemInfo& item) -> bool { return item.Type == eItemType::PISTOL; }) };
+				const int shotgunSlot{ pInventory->GetFirstSlot(eItemType::SHOTGUN) };
+				const int pistolSlot{ pInventory->GetFirstSlot(eItemType::PISTOL) };
 
 				// Check if we have either a shotgun or a pistol in our inventory
-				if ((itShotgun != std::end(*inventory)) || (itPistol != std::end(*inventory)))
+				if ((shotgunSlot != Memory::Inventory::InvalidSlot) || (pistolSlot != Memory::Inventory::InvalidSlot))
 				{
-					AgentInfo agentInfo{};
-					pBlackBoard->GetData("AgentInfo", agentInfo);
-
-					std::vector<EnemyInfo> enemies{};
-					pBlackBoard->GetData("Enemies", enemies);
+					TargetSelector* pTargetSelector{};
+					pBlackBoard->GetData("TargetSelector", pTargetSelector);
+
+					float maximumShotgunDistance{}, maximumShotgunAngle{};
+					pBlackBoard->GetData("MaximumShotgunDistance", maximumShotgunDistance);
+					pBlackBoard->GetData("MaximumShotgunAngle", maximumShotgunAngle);
+
+					float maximumPistolDistance{}, maximumPistolAngle{};
+					pBlackBoard->GetData("MaximumPistolDistance", maximumPistolDistance);
+					pBlackBoard->GetData("MaximumPistolAngle", maximumPistolAngle);
+
+					// Where to aim with either gun, leading the enemies by how far they move while we turn
+					const AgentInfo& agentInfo{ pPerception->Agent };
+					TargetSelector::Solution shotgunSolution{}, pistolSolution{};
+					const bool shotgunTarget{ (shotgunSlot != Memory::Inventory::InvalidSlot) && pTargetSelector->FindShotgunTarget(agentInfo, pPerception->Enemies, maximumShotgunDistance, Elite::ToRadians(maximumShotgunAngle), shotgunSolution) };
+					const bool pistolTarget{ (pistolSlot != Memory::Inventory::InvalidSlot) && pTargetSelector->FindPistolTarget(agentInfo, pPerception->Enemies, maximumPistolDistance, Elite::ToRadians(maximumPistolAngle), pistolSolution) };
+
+					// The pistol hits one enemy at best, so the shotgun goes first when it hits at least as many
+					const bool useShotgun{ shotgunTarget && (!pistolTarget || (shotgunSolution.expectedHits >= pistolSolution.expectedHits)) };
+					if (useShotgun || pistolTarget)
+					{
+						const TargetSelector::Solution& solution{ useShotgun ? shotgunSolution : pistolSolution };
 
-					// Get the closest enemy
-					auto itClosestEnemy{ std::ranges::min_element(enemies, [agentInfo](const EnemyInfo& enemy1, const EnemyInfo& enemy2) -> bool
-						{
-							return agentInfo.Position.DistanceSquared(enemy1.Location) < agentInfo.Position.DistanceSquared(enemy2.Location);
-						}
-					) };
+						// Ask to turn towards where the target will be, this overrides whatever the state machine wanted to look at unless we are escaping
+						MovementBehavior::AimController* pAimController{};
+						pBlackBoard->GetData("AimController", pAimController);
+						pAimController->Request(MovementBehavior::TargetData{ solution.aimPoint, pPerception->Enemies[size_t(solution.target)].LinearVelocity });
 
-					// Check if the closest enemy is not dead already
-					if (itClosestEnemy->Health > 0.0f)
-					{
-						IExamInterface* pInterface{};
-						pBlackBoard->GetData("Interface", pInterface);
-
-						float maximumShotgunDistance{}, maximumShotgunAngle{};
-						pBlackBoard->GetData("MaximumShotgunDistance", maximumShotgunDistance);
-						pBlackBoard->GetData("MaximumShotgunAngle", maximumShotgunAngle);
-
-						float maximumPistolDistance{}, maximumPistolAngle{};
-						pBlackBoard->GetData("MaximumPistolDistance", maximumPistolDistance);
-						pBlackBoard->GetData("MaximumPistolAngle", maximumPistolAngle);
-
-						// Calculate the angle between the player and the closest enemy (in degrees)
-						const Elite::Vector2 agentToEnemy{ (itClosestEnemy->Location - agentInfo.Position) };
-						const float angle{ std::abs(Elite::ToDegrees(Elite::AngleBetween(agentToEnemy, Elite::OrientationToVector(agentInfo.Orientation)))) };
-
-						// Check if we have a shotgun, the enemy is in shotgun range and between the maximum shotgun angle
-						if ((itShotgun != std::end(*inventory)) && (agentInfo.Position.Distance(itClosestEnemy->Location) < maximumShotgunDistance) && (angle < maximumShotgunAngle))
-						{
-							// Shoot the shotgun
-							UINT indexShotgun{ UINT(std::distance(std::begin(*inventory), itShotgun)) };
-							pInterface->Inventory_UseItem(indexShotgun);
-							--inventory->at(indexShotgun).Value;
-
-							// Remove the shotgun if the shotgun is empty (no ammo left)
-							if (inventory->at(indexShotgun).Value <= 0)
-							{
-								pInterface->Inventory_RemoveItem(indexShotgun);
-								inventory->at(indexShotgun) = ItemInfo{ eItemType::GARBAGE };
-							}
-						}
-						// Check if we have a pistol, the enemy is in pistol range and the maximum pistol angle
-						else if ((itPistol != std::end(*inventory)) && (agentInfo.Position.Distance(itClosestEnemy->Location) < maximumPistolDistance) && (angle < maximumPistolAngle))
-						{
-							// Shoot the pistol
-							UINT indexPistol{ UINT(std::distance(std::begin(*inventory), itPistol)) };
-							pInterface->Inventory_UseItem(indexPistol);
-							--inventory->at(indexPistol).Value;
-
-							// Remove the pistol if the pistol is empty (no ammo left)
-							if (inventory->at(indexPistol).Value <= 0)
-							{
-								pInterface->Inventory_RemoveItem(indexPistol);
-								inventory->at(indexPistol) = ItemInfo{ eItemType::GARBAGE };
-							}
-						}
+						// Only pull the trigger once we would hit, the inventory throws the gun away when it is empty (no ammo left)
+						if (pTargetSelector->IsAligned(solution)) pInventory->Use(UINT(useShotgun ? shotgunSlot : pistolSlot));
 					}
 				}
 			}
@@ -108,24 +82,18 @@ namespace DecisionMaking
 			// Are we injured
 			if (agentInfo.Health < 8.0f)
 			{
-				std::vector<ItemInfo>* inventory{};
-				pBlackBoard->GetData("Inventory", inventory);
+				Memory::Inventory* pInventory{};
+				pBlackBoard->GetData("Inventory", pInventory);
 
 				// Do we have healing
-				auto itMedkit{ std::ranges::find_if(*inventory, [](const ItemInfo& item) -> bool { return item.Type == eItemType::MEDKIT; }) };
-				if (itMedkit != std::end(*inventory))
+				const int medkitSlot{ pInventory->GetFirstSlot(eItemType::MEDKIT) };
+				if (medkitSlot != Memory::Inventory::InvalidSlot)
 				{
 					// Will we fully utilize our medkit
-					UINT indexMedkit{ UINT(std::distance(std::begin(*inventory), itMedkit)) };
-					if (10.0f - agentInfo.Energy > inventory->at(indexMedkit).Value)
+					if (10.0f - agentInfo.Energy > pInventory->GetItem(UINT(medkitSlot)).Value)
 					{
-						IExamInterface* pInterface{};
-						pBlackBoard->GetData("Interface", pInterface);
-
 						// Use medkit
-						pInterface->Inventory_UseItem(indexMedkit);
-						pInterface->Inventory_RemoveItem(indexMedkit);
-						inventory->at(indexMedkit) = ItemInfo{ eItemType::GARBAGE };
+						pInventory->Use(UINT(medkitSlot));
 					}
 				}
 			}
@@ -144,29 +112,44 @@ namespace DecisionMaking
 			// Are we tired
 			if (agentInfo.Energy < 8.0f)
 			{
-				std::vector<ItemInfo>* inventory{};
-				pBlackBoard->GetData("Inventory", inventory);
+				Memory::Inventory* pInventory{};
+				pBlackBoard->GetData("Inventory", pInventory);
 
 				// Do we have food
-				auto itFood{ std::ranges::find_if(*inventory, [](const ItemInfo& item) -> bool { return item.Type == eItemType::FOOD; }) };
-				if (itFood != std::end(*inventory))
+				const int foodSlot{ pInventory->GetFirstSlot(eItemType::FOOD) };
+				if (foodSlot != Memory::Inventory::InvalidSlot)
 				{
 					// Will we fully utilize our food
-					UINT indexFood{ UINT(std::distance(std::begin(*inventory), itFood)) };
-					if (10.0f - agentInfo.Energy > inventory->at(indexFood).Value)
+					if (10.0f - agentInfo.Energy > pInventory->GetItem(UINT(foodSlot)).Value)
 					{
-						IExamInterface* pInterface{};
-						pBlackBoard->GetData("Interface", pInterface);
-
 						// Eat the food
-						pInterface->Inventory_UseItem(indexFood);
-						pInterface->Inventory_RemoveItem(indexFood);
-						inventory->at(indexFood) = ItemInfo{ eItemType::GARBAGE };
+						pInventory->Use(UINT(foodSlot));
 					}
 				}
 			}
 
 			return output;
 		}
+
+		State CheckDropping(Blackboard* pBlackBoard)
+		{
+			// Will always return success since we are working with only one sequence in our tree
+			State output{ State::Success };
+
+			Memory::Inventory* pInventory{};
+			pBlackBoard->GetData("Inventory", pInventory);
+
+			InventoryOptimizer* pInventoryOptimizer{};
+			pBlackBoard->GetData("InventoryOptimizer", pInventoryOptimizer);
+
+			StatisticsInfo stats{};
+			pBlackBoard->GetData("StatisticsInfo", stats);
+
+			// Throw away what is worth nothing (a gun without ammo) so the slot is free for something useful
+			const int uselessSlot{ pInventoryOptimizer->FindUselessSlot(*pInventory, stats.Difficulty) };
+			if (uselessSlot != Memory::Inventory::InvalidSlot) pInventory->Remove(UINT(uselessSlot));
+
+			return output;
+		}
 	}
 }
\ No newline at end of file
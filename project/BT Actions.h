@@ -14,6 +14,8 @@ namespace DecisionMaking
 		State CheckHealing(Blackboard* pBlackBoard);
 
 		State CheckFood(Blackboard* pBlackBoard);
+
+		State CheckDropping(Blackboard* pBlackBoard);
 	}
 }
 
@@ -0,0 +1,216 @@
+#include "stdafx.h"
+#include "Batch Steering.h"
+#include "Movement Behaviours.h"
+
+namespace MovementBehavior
+{
+	namespace
+	{
+		// Same operations in the same order as Elite::Vector2::GetNormalized so the results stay bit identical
+		void Normalize(float& x, float& y)
+		{
+			const float magnitude{ sqrtf((x * x) + (y * y)) };
+			const bool isZero{ std::abs(magnitude) <= FLT_EPSILON };
+			const float inverseMagnitude{ 1.0f / (isZero ? 1.0f : magnitude) };
+			x = isZero ? 0.0f : x * inverseMagnitude;
+			y = isZero ? 0.0f : y * inverseMagnitude;
+		}
+	}
+
+#pragma region AgentBatch
+	void AgentBatch::Resize(size_t count)
+	{
+		for (std::vector<float>* pArray : {
+			&positionX, &positionY, &velocityX, &velocityY, &orientation, &maxLinearSpeed, &maxAngularSpeed,
+			&targetPositionX, &targetPositionY, &targetVelocityX, &targetVelocityY,
+			&wanderAngle, &angleDelta,
+			&linearVelocityX, &linearVelocityY, &angularVelocity,
+			&pointX, &pointY })
+		{
+			pArray->resize(count, 0.0f);
+		}
+		smoothingHistory.resize(count);
+	}
+
+	size_t AgentBatch::Size() const
+	{
+		return positionX.size();
+	}
+#pragma endregion
+
+#pragma region BatchSteering
+	void BatchSteering::Seek(AgentBatch& batch, const PathFunctions& pathFunctions)
+	{
+		// Move towards the target
+		std::copy(std::begin(batch.targetPositionX), std::end(batch.targetPositionX), std::begin(batch.pointX));
+		std::copy(std::begin(batch.targetPositionY), std::end(batch.targetPositionY), std::begin(batch.pointY));
+		MakeReachable(batch, pathFunctions, true);
+		SteerTowardsPoints(batch);
+
+		std::fill(std::begin(batch.angularVelocity), std::end(batch.angularVelocity), 0.0f);
+	}
+
+	void BatchSteering::Flee(AgentBatch& batch, const PathFunctions& pathFunctions, float deltaT)
+	{
+		const size_t count{ batch.Size() };
+
+		// Move away from the target
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			float directionX{ batch.positionX[agent] - batch.targetPositionX[agent] };
+			float directionY{ batch.positionY[agent] - batch.targetPositionY[agent] };
+			Normalize(directionX, directionY);
+			batch.pointX[agent] = batch.positionX[agent] + (directionX * 6.0f);
+			batch.pointY[agent] = batch.positionY[agent] + (directionY * 6.0f);
+		}
+		MakeReachable(batch, pathFunctions);
+		SteerTowardsPoints(batch);
+
+		// Look towards the target
+		OrientToTargets(batch, deltaT);
+	}
+
+	void BatchSteering::Arrive(AgentBatch& batch, const PathFunctions& pathFunctions, float deltaT, float slowRadius, float targetRadius)
+	{
+		const size_t count{ batch.Size() };
+
+		// Move towards the target
+		std::copy(std::begin(batch.targetPositionX), std::end(batch.targetPositionX), std::begin(batch.pointX));
+		std::copy(std::begin(batch.targetPositionY), std::end(batch.targetPositionY), std::begin(batch.pointY));
+		MakeReachable(batch, pathFunctions, true);
+
+		// Brake with a constant deceleration and never move further than what is left this frame
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			float directionX{ batch.pointX[agent] - batch.positionX[agent] };
+			float directionY{ batch.pointY[agent] - batch.positionY[agent] };
+			Normalize(directionX, directionY);
+
+			const float differenceX{ batch.positionX[agent] - batch.targetPositionX[agent] };
+			const float differenceY{ batch.positionY[agent] - batch.targetPositionY[agent] };
+			const float distance{ sqrtf((differenceX * differenceX) + (differenceY * differenceY)) };
+			const float remainingDistance{ std::max(distance - targetRadius, 0.0f) };
+			const float deceleration{ (batch.maxLinearSpeed[agent] * batch.maxLinearSpeed[agent]) / (2.0f * std::max(slowRadius - targetRadius, FLT_EPSILON)) };
+			float speed{ std::min(batch.maxLinearSpeed[agent], sqrtf(2.0f * deceleration * remainingDistance)) };
+			if (deltaT > 0.0f) speed = std::min(speed, remainingDistance / deltaT);
+
+			batch.linearVelocityX[agent] = directionX * speed;
+			batch.linearVelocityY[agent] = directionY * speed;
+			batch.angularVelocity[agent] = 0.0f;
+		}
+	}
+
+	void BatchSteering::Pursuit(AgentBatch& batch, const PathFunctions& pathFunctions)
+	{
+		const size_t count{ batch.Size() };
+
+		// Move towards where the target is going to be
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			const float differenceX{ batch.positionX[agent] - batch.targetPositionX[agent] };
+			const float differenceY{ batch.positionY[agent] - batch.targetPositionY[agent] };
+			const float distance{ sqrtf((differenceX * differenceX) + (differenceY * differenceY)) };
+			const float time{ distance / batch.maxLinearSpeed[agent] };
+			batch.pointX[agent] = batch.targetPositionX[agent] + (time * batch.targetVelocityX[agent]);
+			batch.pointY[agent] = batch.targetPositionY[agent] + (time * batch.targetVelocityY[agent]);
+		}
+		MakeReachable(batch, pathFunctions);
+		SteerTowardsPoints(batch);
+
+		std::fill(std::begin(batch.angularVelocity), std::end(batch.angularVelocity), 0.0f);
+	}
+
+	void BatchSteering::Evade(AgentBatch& batch, const PathFunctions& pathFunctions, float deltaT)
+	{
+		const size_t count{ batch.Size() };
+
+		// Move away from where the target is going
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			const float differenceX{ batch.positionX[agent] - batch.targetPositionX[agent] };
+			const float differenceY{ batch.positionY[agent] - batch.targetPositionY[agent] };
+			const float distance{ sqrtf((differenceX * differenceX) + (differenceY * differenceY)) };
+			const float time{ distance / batch.maxLinearSpeed[agent] };
+			batch.pointX[agent] = batch.targetPositionX[agent] + (batch.targetVelocityX[agent] * time);
+			batch.pointY[agent] = batch.targetPositionY[agent] + (batch.targetVelocityY[agent] * time);
+		}
+		MakeReachable(batch, pathFunctions);
+
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			float directionX{ batch.positionX[agent] - batch.pointX[agent] };
+			float directionY{ batch.positionY[agent] - batch.pointY[agent] };
+			Normalize(directionX, directionY);
+			batch.linearVelocityX[agent] = directionX * batch.maxLinearSpeed[agent];
+			batch.linearVelocityY[agent] = directionY * batch.maxLinearSpeed[agent];
+		}
+
+		// Look at the target
+		OrientToTargets(batch, deltaT);
+	}
+
+	void BatchSteering::Wander(AgentBatch& batch, const PathFunctions& pathFunctions, float offset, float radius)
+	{
+		const size_t count{ batch.Size() };
+
+		// Move towards a random point on a circle in front of every agent
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			float directionX{ batch.velocityX[agent] };
+			float directionY{ batch.velocityY[agent] };
+			Normalize(directionX, directionY);
+			const float centerX{ batch.positionX[agent] + (directionX * offset) };
+			const float centerY{ batch.positionY[agent] + (directionY * offset) };
+
+			batch.wanderAngle[agent] += batch.angleDelta[agent];
+			batch.pointX[agent] = centerX + radius * cosf(batch.wanderAngle[agent]);
+			batch.pointY[agent] = centerY + radius * sinf(batch.wanderAngle[agent]);
+		}
+		MakeReachable(batch, pathFunctions);
+		SteerTowardsPoints(batch);
+
+		std::fill(std::begin(batch.angularVelocity), std::end(batch.angularVelocity), 0.0f);
+	}
+
+	void BatchSteering::MakeReachable(AgentBatch& batch, const PathFunctions& pathFunctions, bool smooth)
+	{
+		// The nav mesh lives in the host, so this is the only part that has to be done one agent at a time
+		const size_t count{ batch.Size() };
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			const Elite::Vector2 target{ batch.pointX[agent], batch.pointY[agent] };
+			Elite::Vector2 point{ pathFunctions.pathfinding(target) };
+			if (smooth && pathFunctions.smoothing) point = pathFunctions.smoothing(batch.smoothingHistory[agent], Elite::Vector2{ batch.positionX[agent], batch.positionY[agent] }, point, target);
+			batch.pointX[agent] = point.x;
+			batch.pointY[agent] = point.y;
+		}
+	}
+
+	void BatchSteering::SteerTowardsPoints(AgentBatch& batch)
+	{
+		const size_t count{ batch.Size() };
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			float directionX{ batch.pointX[agent] - batch.positionX[agent] };
+			float directionY{ batch.pointY[agent] - batch.positionY[agent] };
+			Normalize(directionX, directionY);
+			batch.linearVelocityX[agent] = directionX * batch.maxLinearSpeed[agent];
+			batch.linearVelocityY[agent] = directionY * batch.maxLinearSpeed[agent];
+		}
+	}
+
+	void BatchSteering::OrientToTargets(AgentBatch& batch, float deltaT)
+	{
+		const size_t count{ batch.Size() };
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			const Elite::Vector2 direction{ batch.targetPositionX[agent] - batch.positionX[agent], batch.targetPositionY[agent] - batch.positionY[agent] };
+			const float orientationDifference{ Elite::AngleBetween(Elite::OrientationToVector(batch.orientation[agent]), direction) };
+
+			// Same as OrientTo, full speed but never past the target within one frame
+			const float angularSpeed{ std::min(batch.maxAngularSpeed[agent], std::abs(orientationDifference) / std::max(deltaT, FLT_MIN)) };
+			batch.angularVelocity[agent] = std::copysign(angularSpeed, orientationDifference);
+		}
+	}
+#pragma endregion
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef BATCH_STEERING_BEHAVIOURS
+#define BATCH_STEERING_BEHAVIOURS
+
+#include "Path Smoother.h"
+#include <vector>
+
+namespace MovementBehavior
+{
+	struct PathFunctions;
+
+	// Structure of arrays with one entry per agent, every array has the same size
+	struct AgentBatch final
+	{
+		void Resize(size_t count);
+		size_t Size() const;
+
+		// Agents
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<float> orientation;
+		std::vector<float> maxLinearSpeed;
+		std::vector<float> maxAngularSpeed;
+
+		// Targets
+		std::vector<float> targetPositionX;
+		std::vector<float> targetPositionY;
+		std::vector<float> targetVelocityX;
+		std::vector<float> targetVelocityY;
+
+		// Wander state, the angle deltas have to be filled in by the caller every frame
+		std::vector<float> wanderAngle;
+		std::vector<float> angleDelta;
+
+		// Output, auto orient is false for flee and evade and true for all the others (same as the single agent behaviours)
+		std::vector<float> linearVelocityX;
+		std::vector<float> linearVelocityY;
+		std::vector<float> angularVelocity;
+
+		// Scratch space for points that have to go through the nav mesh
+		std::vector<float> pointX;
+		std::vector<float> pointY;
+
+		// What the smoother remembers about the path of every agent, so agents don't overwrite each other's corners
+		std::vector<Navigation::SmoothingHistory> smoothingHistory;
+	};
+
+	// Runs the single agent steering behaviours for a whole batch of agents at once, results are bit identical to the single agent versions
+	class BatchSteering final
+	{
+	public:
+		BatchSteering() = delete;
+		~BatchSteering() = delete;
+
+		BatchSteering(const BatchSteering& other) = delete;
+		BatchSteering& operator=(const BatchSteering& other) = delete;
+		BatchSteering(BatchSteering&& other) = delete;
+		BatchSteering& operator=(BatchSteering&& other) = delete;
+
+		// Every agent goes through the same nav mesh and smoother, the ones the single agent versions were made with
+		static void Seek(AgentBatch& batch, const PathFunctions& pathFunctions);
+		static void Flee(AgentBatch& batch, const PathFunctions& pathFunctions, float deltaT);
+		static void Arrive(AgentBatch& batch, const PathFunctions& pathFunctions, float deltaT, float slowRadius = 15.0f, float targetRadius = 3.0f);
+		static void Pursuit(AgentBatch& batch, const PathFunctions& pathFunctions);
+		static void Evade(AgentBatch& batch, const PathFunctions& pathFunctions, float deltaT);
+		static void Wander(AgentBatch& batch, const PathFunctions& pathFunctions, float offset = 6.0f, float radius = 4.0f);
+
+	private:
+		// Seek and arrive go through the smoother like the single agent versions, the others only through the nav mesh
+		static void MakeReachable(AgentBatch& batch, const PathFunctions& pathFunctions, bool smooth = false);
+		static void SteerTowardsPoints(AgentBatch& batch);
+		static void OrientToTargets(AgentBatch& batch, float deltaT);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "stdafx.h"
+#include "Benchmarks.h"
+
+// Runs every benchmark and check once, in their own program so none of them stalls the game or touches the plugin's steering
+int main()
+{
+	Benchmarks::RunHashing();
+	Benchmarks::RunPerception();
+	Benchmarks::RunTargeting();
+	Benchmarks::RunAiming();
+	Benchmarks::CheckPathSmoothing();
+	Benchmarks::CheckBatchSteering();
+
+	return 0;
+}
\ No newline at end of file
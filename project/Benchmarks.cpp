@@ -0,0 +1,640 @@
+#include "stdafx.h"
+#include "Benchmarks.h"
+#include "Exam_HelperStructs.h"
+#include "Flat Hash Map.h"
+#include "Blackboard.h"
+#include "Perception.h"
+#include "Target Selector.h"
+#include "Aim Controller.h"
+#include "Path Smoother.h"
+#include "Batch Steering.h"
+#include <unordered_set>
+#include <chrono>
+#include <bit>
+
+namespace
+{
+	// The hashes we used to have, kept here to compare against
+	struct ValueItemHash final
+	{
+		std::size_t operator()(const ItemInfo& item) const { return std::hash<int>()(item.Value); }
+	};
+
+	struct SummedHouseHash final
+	{
+		std::size_t operator()(const HouseInfo& house) const { return std::hash<float>()(house.Center.x) + std::hash<float>()(house.Center.y); }
+	};
+
+	// Inserts all items and then looks them up over and over, returns the microseconds it took
+	template<typename Set, typename InsertFunction, typename ContainsFunction>
+	long long TimeSet(Set& set, const std::vector<ItemInfo>& items, int lookupCount, InsertFunction insert, ContainsFunction contains, int& found)
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+
+		std::ranges::for_each(items, [&set, &insert](const ItemInfo& item) -> void { insert(set, item); });
+		for (int lookup{}; lookup < lookupCount; ++lookup)
+		{
+			if (contains(set, items[size_t(lookup) % items.size()])) ++found;
+		}
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	// What the interface hands us every tick, new vectors every time
+	struct InterfaceData final
+	{
+		AgentInfo agentInfo;
+		std::vector<HouseInfo> houses;
+		std::vector<EnemyInfo> enemies;
+		std::vector<PurgeZoneInfo> purgeZones;
+		std::vector<ItemInfo> items;
+	};
+
+	// The blackboard update and the readers like they used to be, every FOV list gets its own key and every reader copies them out and looks for the closest itself
+	float TickSeparately(DecisionMaking::Blackboard& blackboard, const InterfaceData& data)
+	{
+		blackboard.ChangeData("StatisticsInfo", StatisticsInfo{});
+		blackboard.ChangeData("Houses", HousesInFOV{ std::vector<HouseInfo>{ data.houses } });
+		blackboard.ChangeData("Enemies", EnemiesInFOV{ std::vector<EnemyInfo>{ data.enemies } });
+		blackboard.ChangeData("PurgeZones", PurgeZonesInFOV{ std::vector<PurgeZoneInfo>{ data.purgeZones } });
+		blackboard.ChangeData("Items", ItemsInFOV{ std::vector<ItemInfo>{ data.items } });
+		blackboard.ChangeData("FOVStats", FOVStats{});
+		blackboard.ChangeData("AgentInfo", data.agentInfo);
+
+		AgentInfo agentInfo{};
+		blackboard.GetData("AgentInfo", agentInfo);
+		const auto closerTo{ [&agentInfo](const auto& info1, const auto& info2) -> bool { return agentInfo.Position.DistanceSquared(info1.Location) < agentInfo.Position.DistanceSquared(info2.Location); } };
+
+		// Escape
+		EnemiesInFOV enemies{};
+		blackboard.GetData("Enemies", enemies);
+		HousesInFOV houses{};
+		blackboard.GetData("Houses", houses);
+		float output{ std::ranges::min_element(enemies, closerTo)->Location.x + float(houses.size()) };
+
+		// Shooting
+		blackboard.GetData("Enemies", enemies);
+		const auto itClosestEnemy{ std::ranges::min_element(enemies, closerTo) };
+		output += agentInfo.Position.Distance(itClosestEnemy->Location) + Elite::AngleBetween(itClosestEnemy->Location - agentInfo.Position, Elite::OrientationToVector(agentInfo.Orientation));
+
+		// Item in sight and going for the closest one
+		ItemsInFOV items{};
+		blackboard.GetData("Items", items);
+		if (!items.empty()) output += std::ranges::min_element(items, closerTo)->Location.y;
+
+		// Unexplored house in sight
+		blackboard.GetData("Houses", houses);
+		return output + float(houses.size());
+	}
+
+	// The same tick on the perception frame
+	float TickFrame(DecisionMaking::Blackboard& blackboard, const InterfaceData& data)
+	{
+		PerceptionFrame* pPerception{};
+		blackboard.GetData("Perception", pPerception);
+		pPerception->Build(data.agentInfo, StatisticsInfo{}, FOVStats{}, std::vector<HouseInfo>{ data.houses }, std::vector<EnemyInfo>{ data.enemies }, std::vector<PurgeZoneInfo>{ data.purgeZones }, std::vector<ItemInfo>{ data.items });
+		blackboard.ChangeData("StatisticsInfo", pPerception->Stats);
+		blackboard.ChangeData("FOVStats", pPerception->FOV);
+		blackboard.ChangeData("AgentInfo", pPerception->Agent);
+
+		float output{ pPerception->GetClosestEnemy()->Location.x + float(pPerception->Houses.size()) };
+		output += pPerception->EnemyDistances.front() + pPerception->EnemyAngles.front();
+		if (!pPerception->Items.empty()) output += pPerception->GetClosestItem()->Location.y;
+
+		return output + float(pPerception->Houses.size());
+	}
+
+	// Runs a tick over and over, returns the microseconds one took on average
+	template<typename TickFunction>
+	float TimeTicks(DecisionMaking::Blackboard& blackboard, const InterfaceData& data, int tickCount, TickFunction tick, float& checksum)
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+		for (int index{}; index < tickCount; ++index) checksum += tick(blackboard, data);
+
+		return float(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()) / float(tickCount);
+	}
+
+	// How the simulated agent picks its shots
+	enum class eAimMode
+	{
+		ClosestInCone,		// Look around and fire when the closest enemy happens to be inside one of the cones
+		FaceClosest,		// Turn towards where the closest enemy in range is right now, without leading it
+		Predictive			// Turn towards where the target selector says its target will be
+	};
+
+	// What one shooting run came down to, a miss is a shot that hit nobody
+	struct ShootingResult final
+	{
+		int shots{};
+		int hits{};
+		int kills{};
+		int misses{};
+	};
+
+	// Every pellet is a ray with some spread that stops at the first body it passes through, nothing here comes from the target selector
+	// Returns the index of the enemy it hit or -1
+	int TracePellet(const Elite::Vector2& direction, const std::vector<EnemyInfo>& enemies, float reach)
+	{
+		int hit{ -1 };
+		float hitDistance{ reach };
+		for (size_t index{}; index < enemies.size(); ++index)
+		{
+			const EnemyInfo& enemy{ enemies[index] };
+			const float along{ direction.Dot(enemy.Location) };
+			const float sideSquared{ enemy.Location.MagnitudeSquared() - (along * along) };
+			const float radiusSquared{ enemy.Size * enemy.Size };
+			if ((along <= 0.0f) || (sideSquared >= radiusSquared)) continue;
+
+			const float entry{ along - sqrtf(radiusSquared - sideSquared) };
+			if (entry >= hitDistance) continue;
+
+			hit = int(index);
+			hitDistance = entry;
+		}
+
+		return hit;
+	}
+
+	// A standing agent with both guns and a few enemies walking in on it, the agent looks around on its own when it isn't aiming
+	// The same seed spawns the same enemies and looks the same way for every mode, until the shots start changing who is still alive
+	ShootingResult SimulateShooting(uint32_t seed, int enemyCount, float duration, eAimMode mode)
+	{
+		constexpr float deltaTime{ 1.0f / 60.0f };
+		constexpr float fireCooldown{ 0.5f };
+		constexpr float shotgunDistance{ 5.0f }, shotgunAngle{ 20.0f };
+		constexpr float pistolDistance{ 7.0f }, pistolAngle{ 10.0f };
+
+		// The guns themselves, eight pellets spread over the shotgun's cone and a pistol that is a little off now and then
+		constexpr float shotgunReach{ 6.0f }, pistolReach{ 15.0f };
+		constexpr int pelletCount{ 8 };
+		constexpr float pistolSpread{ 1.0f };
+
+		std::mt19937 generator{ seed };
+		std::mt19937 spreadGenerator{ ~seed };
+		std::uniform_real_distribution<float> spawnDistance{ 3.0f, 9.0f };
+		std::uniform_real_distribution<float> angle{ -float(E_PI), float(E_PI) };
+		std::uniform_real_distribution<float> approachSpeed{ 1.0f, 3.0f };
+		std::uniform_real_distribution<float> sideSpeed{ -1.5f, 1.5f };
+		std::uniform_real_distribution<float> lookChange{ -0.2f, 0.2f };
+		std::uniform_int_distribution<int> health{ 1, 3 };
+
+		AgentInfo agentInfo{};
+		agentInfo.MaxAngularSpeed = float(E_PI);
+		const auto spawn{ [&](EnemyInfo& enemy) -> void
+			{
+				const Elite::Vector2 direction{ Elite::OrientationToVector(angle(generator)) };
+				enemy.Location = direction * spawnDistance(generator);
+				enemy.LinearVelocity = direction * -approachSpeed(generator) + Elite::Vector2{ -direction.y, direction.x } * sideSpeed(generator);
+				enemy.Size = 0.5f;
+				enemy.Health = float(health(generator));
+			} };
+		std::vector<EnemyInfo> enemies(size_t(enemyCount), EnemyInfo{});
+		std::ranges::for_each(enemies, spawn);
+
+		const DecisionMaking::TargetSelector targetSelector{};
+		MovementBehavior::AimController aimController{};
+		ShootingResult result{};
+		float lookVelocity{}, cooldown{};
+		for (float time{}; time < duration; time += deltaTime)
+		{
+			// Closest first like the perception frame hands them out
+			std::ranges::sort(enemies, [](const EnemyInfo& first, const EnemyInfo& second) -> bool { return first.Location.MagnitudeSquared() < second.Location.MagnitudeSquared(); });
+			const Elite::Vector2 forward{ Elite::OrientationToVector(agentInfo.Orientation) };
+			lookVelocity = std::clamp(lookVelocity + lookChange(generator), -1.0f, 1.0f);
+			float angularVelocity{ lookVelocity };
+			cooldown -= deltaTime;
+
+			bool fire{}, shotgun{};
+			const float distance{ enemies.front().Location.Magnitude() };
+			const float enemyAngle{ std::abs(Elite::AngleBetween(forward, enemies.front().Location)) };
+			switch (mode)
+			{
+			case eAimMode::ClosestInCone:
+				shotgun = (distance < shotgunDistance) && (enemyAngle < Elite::ToRadians(shotgunAngle));
+				fire = shotgun || ((distance < pistolDistance) && (enemyAngle < Elite::ToRadians(pistolAngle)));
+				break;
+			case eAimMode::FaceClosest:
+				// Fire once the closest one is inside the shotgun's cone or right in front of the pistol
+				if (distance < pistolDistance)
+				{
+					angularVelocity = aimController.CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ enemies.front().Location, Elite::Vector2{} }).AngularVelocity;
+					shotgun = (distance < shotgunDistance) && (enemyAngle < Elite::ToRadians(shotgunAngle));
+					fire = shotgun || (enemyAngle < std::asin(std::min(enemies.front().Size / distance, 1.0f)));
+				}
+				break;
+			case eAimMode::Predictive:
+				{
+					DecisionMaking::TargetSelector::Solution solution{};
+					shotgun = targetSelector.FindShotgunTarget(agentInfo, enemies, shotgunDistance, Elite::ToRadians(shotgunAngle), solution);
+					if (shotgun || targetSelector.FindPistolTarget(agentInfo, enemies, pistolDistance, Elite::ToRadians(pistolAngle), solution))
+					{
+						angularVelocity = aimController.CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ solution.aimPoint, enemies[size_t(solution.target)].LinearVelocity }).AngularVelocity;
+						fire = targetSelector.IsAligned(solution);
+					}
+				}
+				break;
+			}
+
+			if (fire && (cooldown <= 0.0f))
+			{
+				// Every enemy a pellet passes through is hit once, the pistol fires a single pellet
+				cooldown = fireCooldown;
+				++result.shots;
+				std::vector<bool> hit(enemies.size(), false);
+				const float spread{ Elite::ToRadians(shotgun ? shotgunAngle : pistolSpread) };
+				std::uniform_real_distribution<float> pelletAngle{ -spread, spread };
+				for (int pellet{}; pellet < (shotgun ? pelletCount : 1); ++pellet)
+				{
+					const int enemy{ TracePellet(Elite::OrientationToVector(agentInfo.Orientation + pelletAngle(spreadGenerator)), enemies, shotgun ? shotgunReach : pistolReach) };
+					if (enemy >= 0) hit[size_t(enemy)] = true;
+				}
+
+				int hits{};
+				for (size_t index{}; index < enemies.size(); ++index)
+				{
+					if (!hit[index]) continue;
+
+					++hits;
+					enemies[index].Health -= 1.0f;
+					if (enemies[index].Health > 0.0f) continue;
+
+					++result.kills;
+					spawn(enemies[index]);
+				}
+
+				result.hits += hits;
+				if (hits == 0) ++result.misses;
+			}
+
+			// Everyone moves, the ones that reached us start over somewhere else
+			agentInfo.AngularVelocity = angularVelocity;
+			agentInfo.Orientation += angularVelocity * deltaTime;
+			for (EnemyInfo& enemy : enemies)
+			{
+				enemy.Location += enemy.LinearVelocity * deltaTime;
+				if (enemy.Location.Magnitude() < 1.0f) spawn(enemy);
+			}
+		}
+
+		return result;
+	}
+
+	// How long TimeToAlign waits for a turn to settle
+	constexpr float AlignTimeOut{ 3.0f };
+
+	// Seconds until we face a moving target and stay facing it, -1 when it doesn't settle in time, the biggest swing past it goes in overshoot
+	template<typename TurnFunction>
+	float TimeToAlign(const AgentInfo& startInfo, const MovementBehavior::TargetData& startTarget, float alignedAngle, TurnFunction turn, float& overshoot)
+	{
+		constexpr float deltaTime{ 1.0f / 60.0f };
+		constexpr float settleTime{ 0.25f };
+
+		AgentInfo agentInfo{ startInfo };
+		MovementBehavior::TargetData target{ startTarget };
+		float alignedSince{ -1.0f };
+		float previousError{ Elite::AngleBetween(Elite::OrientationToVector(agentInfo.Orientation), target.position - agentInfo.Position) };
+		for (float time{}; time < AlignTimeOut; time += deltaTime)
+		{
+			const float error{ Elite::AngleBetween(Elite::OrientationToVector(agentInfo.Orientation), target.position - agentInfo.Position) };
+			if ((error * previousError) < 0.0f) overshoot = std::max(overshoot, std::abs(error));
+			previousError = error;
+
+			if (std::abs(error) > alignedAngle) alignedSince = -1.0f;
+			else if (alignedSince < 0.0f) alignedSince = time;
+			if ((alignedSince >= 0.0f) && ((time - alignedSince) >= settleTime)) return alignedSince;
+
+			agentInfo.AngularVelocity = turn(deltaTime, agentInfo, target);
+			agentInfo.Orientation += agentInfo.AngularVelocity * deltaTime;
+			target.position += target.velocity * deltaTime;
+		}
+
+		return -1.0f;
+	}
+
+	// Same bits, so -0 against 0 and different NaNs count as a difference too
+	bool IsBitIdentical(float value1, float value2)
+	{
+		return std::bit_cast<uint32_t>(value1) == std::bit_cast<uint32_t>(value2);
+	}
+}
+
+namespace Benchmarks
+{
+	void RunHashing(int itemCount, int lookupCount)
+	{
+		// Items like the game gives them, unique hashes but only a handful of different values
+		std::vector<ItemInfo> items{};
+		for (int index{}; index < itemCount; ++index)
+		{
+			items.push_back(ItemInfo{ eItemType(index % 5), Elite::Vector2{ float(index), float(-index) }, 1000 + (index * 7), 1 + (index % 10) });
+		}
+
+		int found{};
+		std::unordered_set<ItemInfo, ValueItemHash> oldSet{};
+		const long long oldTime{ TimeSet(oldSet, items, lookupCount, [](auto& set, const ItemInfo& item) -> void { set.insert(item); }, [](const auto& set, const ItemInfo& item) -> bool { return set.contains(item); }, found) };
+
+		std::unordered_set<ItemInfo> newSet{};
+		const long long newTime{ TimeSet(newSet, items, lookupCount, [](auto& set, const ItemInfo& item) -> void { set.insert(item); }, [](const auto& set, const ItemInfo& item) -> bool { return set.contains(item); }, found) };
+
+		Containers::FlatHashSet<ItemInfo> flatSet{};
+		const long long flatTime{ TimeSet(flatSet, items, lookupCount, [](auto& set, const ItemInfo& item) -> void { set.Insert(item); }, [](const auto& set, const ItemInfo& item) -> bool { return set.Contains(item); }, found) };
+
+		std::cout << "Hashing " << itemCount << " items, " << lookupCount << " lookups (" << found << " found)" << std::endl;
+		std::cout << "  unordered_set, value hash: " << oldTime << "us" << std::endl;
+		std::cout << "  unordered_set, item hash:  " << newTime << "us" << std::endl;
+		std::cout << "  flat hash set, item hash:  " << flatTime << "us" << std::endl;
+
+		// Houses on a grid that is mirrored around the center of the world, count how many share a hash
+		std::vector<HouseInfo> houses{};
+		for (int x{ -10 }; x <= 10; ++x)
+		{
+			for (int y{ -10 }; y <= 10; ++y) houses.push_back(HouseInfo{ Elite::Vector2{ x * 25.0f, y * 25.0f }, Elite::Vector2{ 20.0f, 20.0f } });
+		}
+
+		std::unordered_set<std::size_t> oldHashes{}, newHashes{};
+		std::ranges::for_each(houses, [&oldHashes, &newHashes](const HouseInfo& house) -> void
+			{
+				oldHashes.insert(SummedHouseHash{}(house));
+				newHashes.insert(std::hash<HouseInfo>{}(house));
+			});
+
+		std::cout << "Hashing " << houses.size() << " houses, distinct hashes: summed " << oldHashes.size() << ", quantized " << newHashes.size() << std::endl;
+	}
+
+	void RunPerception(int enemyCount, int itemCount, int tickCount)
+	{
+		// A crowded view, the frames where this matters
+		std::mt19937 generator{ 4 };
+		std::uniform_real_distribution<float> coordinate{ -15.0f, 15.0f };
+		InterfaceData data{};
+		data.agentInfo.Orientation = 0.5f;
+		data.houses.push_back(HouseInfo{ Elite::Vector2{ 10.0f, 0.0f }, Elite::Vector2{ 20.0f, 20.0f } });
+		data.enemies.resize(size_t(enemyCount));
+		std::ranges::for_each(data.enemies, [&generator, &coordinate](EnemyInfo& enemy) -> void { enemy.Location = Elite::Vector2{ coordinate(generator), coordinate(generator) }; });
+		data.items.resize(size_t(itemCount));
+		std::ranges::for_each(data.items, [&generator, &coordinate](ItemInfo& item) -> void { item.Location = Elite::Vector2{ coordinate(generator), coordinate(generator) }; });
+
+		// Both blackboards only hold what their version of the plugin kept about perception
+		DecisionMaking::Blackboard separateBlackboard{};
+		separateBlackboard.AddData("StatisticsInfo", StatisticsInfo{});
+		separateBlackboard.AddData("Houses", HousesInFOV{});
+		separateBlackboard.AddData("Enemies", EnemiesInFOV{});
+		separateBlackboard.AddData("PurgeZones", PurgeZonesInFOV{});
+		separateBlackboard.AddData("Items", ItemsInFOV{});
+		separateBlackboard.AddData("FOVStats", FOVStats{});
+		separateBlackboard.AddData("AgentInfo", AgentInfo{});
+
+		PerceptionFrame perception{};
+		DecisionMaking::Blackboard frameBlackboard{};
+		frameBlackboard.AddData("StatisticsInfo", StatisticsInfo{});
+		frameBlackboard.AddData("FOVStats", FOVStats{});
+		frameBlackboard.AddData("AgentInfo", AgentInfo{});
+		frameBlackboard.AddData("Perception", &perception);
+
+		// Timed the same way, everything else a tick does didn't change between the two
+		float checksum{};
+		const float separateTime{ TimeTicks(separateBlackboard, data, tickCount, TickSeparately, checksum) };
+		const float frameTime{ TimeTicks(frameBlackboard, data, tickCount, TickFrame, checksum) };
+
+		std::cout << "Perception with " << enemyCount << " enemies and " << itemCount << " items, " << tickCount << " ticks (checksum " << checksum << ")" << std::endl;
+		std::cout << "  separate lookups: " << separateTime << "us per tick" << std::endl;
+		std::cout << "  perception frame: " << frameTime << "us per tick" << std::endl;
+	}
+
+	void RunTargeting(int seedCount, int enemyCount, float duration)
+	{
+		// Waiting for the closest enemy to wander into a cone, turning towards the closest one and turning towards where the best target will be
+		constexpr std::array<eAimMode, 3> modes{ eAimMode::ClosestInCone, eAimMode::FaceClosest, eAimMode::Predictive };
+		std::array<ShootingResult, 3> results{};
+		for (int seed{}; seed < seedCount; ++seed)
+		{
+			for (size_t mode{}; mode < modes.size(); ++mode)
+			{
+				const ShootingResult result{ SimulateShooting(uint32_t(seed), enemyCount, duration, modes[mode]) };
+				results[mode].shots += result.shots;
+				results[mode].hits += result.hits;
+				results[mode].kills += result.kills;
+				results[mode].misses += result.misses;
+			}
+		}
+
+		// Scored like the game does, 5 for every hit, 15 for every kill and -5 for every shot that hits nobody
+		std::cout << "Targeting with " << enemyCount << " enemies taking 1 to 3 hits, " << seedCount << " runs of " << duration << " seconds" << std::endl;
+		const std::array<const char*, 3> names{ "  closest in cone: ", "  face closest, no lead: ", "  predictive aim: " };
+		for (size_t index{}; index < results.size(); ++index)
+		{
+			const ShootingResult& result{ results[index] };
+			const float shots{ float(std::max(result.shots, 1)) };
+			const float score{ (5.0f * float(result.hits)) + (15.0f * float(result.kills)) - (5.0f * float(result.misses)) };
+			std::cout << names[index] << result.shots << " shots, hit rate " << (float(result.shots - result.misses) / shots) << ", " << (float(result.hits) / shots) << " hits and " << (float(result.kills) / shots) << " kills per shot, " << (score / shots) << " score per ammo" << std::endl;
+		}
+	}
+
+	void RunAiming(int targetCount, float maximumTargetSpeed)
+	{
+		// Random bearings all around us, the targets walk in random directions
+		std::mt19937 generator{ 7 };
+		std::uniform_real_distribution<float> angle{ -float(E_PI), float(E_PI) };
+		std::uniform_real_distribution<float> distance{ 3.0f, 10.0f };
+		std::uniform_real_distribution<float> speed{ 0.0f, maximumTargetSpeed };
+		AgentInfo agentInfo{};
+		agentInfo.MaxAngularSpeed = float(E_PI);
+		const float alignedAngle{ Elite::ToRadians(2.0f) };
+
+		// Full speed left or right until we face it, like the steering behaviours used to turn
+		const auto bangBang{ [](float, const AgentInfo& agentInfo, const MovementBehavior::TargetData& target) -> float
+			{
+				const float error{ Elite::AngleBetween(Elite::OrientationToVector(agentInfo.Orientation), target.position - agentInfo.Position) };
+				return Elite::AreEqual(error, 0.0f) ? 0.0f : std::copysign(agentInfo.MaxAngularSpeed, error);
+			} };
+		// The steering behaviours now, full speed but never past the target within one frame (flee looks at its target with it)
+		// Where flee runs to doesn't matter here, so it gets a nav mesh that takes every point as it is
+		MovementBehavior::PathFunctions pathFunctions{};
+		pathFunctions.pathfinding = [](const Elite::Vector2& point) -> Elite::Vector2 { return point; };
+		MovementBehavior::Flee flee{ pathFunctions };
+		const auto cappedTurn{ [&flee](float deltaTime, const AgentInfo& agentInfo, const MovementBehavior::TargetData& target) -> float { return flee.CalculateSteering(deltaTime, agentInfo, target).AngularVelocity; } };
+		MovementBehavior::AimController aimController{};
+		const auto aim{ [&aimController](float deltaTime, const AgentInfo& agentInfo, const MovementBehavior::TargetData& target) -> float { return aimController.CalculateSteering(deltaTime, agentInfo, target).AngularVelocity; } };
+
+		// Runs that don't settle count as the whole time out, so a turn that never settles can't look fast
+		std::array<float, 3> totalTimes{}, overshoots{};
+		std::array<int, 3> unsettled{};
+		for (int target{}; target < targetCount; ++target)
+		{
+			const MovementBehavior::TargetData targetData{ Elite::OrientationToVector(angle(generator)) * distance(generator), Elite::OrientationToVector(angle(generator)) * speed(generator) };
+			const std::array<float, 3> times{ TimeToAlign(agentInfo, targetData, alignedAngle, bangBang, overshoots[0]), TimeToAlign(agentInfo, targetData, alignedAngle, cappedTurn, overshoots[1]), TimeToAlign(agentInfo, targetData, alignedAngle, aim, overshoots[2]) };
+			for (size_t index{}; index < times.size(); ++index)
+			{
+				if (times[index] >= 0.0f) totalTimes[index] += times[index];
+				else
+				{
+					totalTimes[index] += AlignTimeOut;
+					++unsettled[index];
+				}
+			}
+		}
+
+		std::cout << "Aiming at " << targetCount << " targets moving up to " << maximumTargetSpeed << " m/s, aligned within 2 degrees for 0.25s, giving up after " << AlignTimeOut << "s" << std::endl;
+		const std::array<const char*, 3> names{ "  full speed turning: ", "  capped orient to: ", "  aim controller: " };
+		for (size_t index{}; index < names.size(); ++index)
+		{
+			std::cout << names[index] << (totalTimes[index] / float(std::max(targetCount, 1))) << "s to align on average, " << unsettled[index] << " never settled, largest overshoot " << Elite::ToDegrees(overshoots[index]) << " degrees" << std::endl;
+		}
+	}
+
+	void CheckPathSmoothing()
+	{
+		// A 10 by 10 house at the origin with its door on the right, the nav mesh hands out the door while we are inside or going in
+		Navigation::PathSmoother pathSmoother{};
+		pathSmoother.AddObstacle(Elite::Vector2{}, Elite::Vector2{ 10.0f, 10.0f });
+		const Elite::Vector2 door{ 5.0f, 0.0f };
+
+		const auto check{ [&pathSmoother](const char* name, const Elite::Vector2& position, const Elite::Vector2& pathPoint, const Elite::Vector2& target, const Elite::Vector2& expected) -> void
+			{
+				Navigation::SmoothingHistory history{};
+				const Elite::Vector2 point{ pathSmoother.Smooth(history, position, pathPoint, target) };
+				std::cout << "  " << name << ": " << ((point.DistanceSquared(expected) < 0.01f) ? "ok" : "FAILED") << ", steered to " << point << std::endl;
+			} };
+
+		std::cout << "Path smoothing around a house" << std::endl;
+		// The target is in sight once we ignore the house we are in, but the only way out is the door
+		check("inside to outside through the door", Elite::Vector2{ -2.0f, 3.0f }, door, Elite::Vector2{ -20.0f, 3.0f }, door);
+		check("outside to inside through the door", Elite::Vector2{ -20.0f, 3.0f }, Elite::Vector2{ -5.0f, 9.0f }, Elite::Vector2{ -2.0f, 3.0f }, Elite::Vector2{ -5.0f, 9.0f });
+		check("outside to outside in sight", Elite::Vector2{ -20.0f, 20.0f }, Elite::Vector2{ -10.0f, 20.0f }, Elite::Vector2{ 20.0f, 20.0f }, Elite::Vector2{ 20.0f, 20.0f });
+	}
+
+	void CheckBatchSteering(int agentCount, int frameCount)
+	{
+		using namespace MovementBehavior;
+
+		// The smoother the plugin uses, with a house every 20 meters to cut corners around
+		Navigation::PathSmoother pathSmoother{};
+		for (float x{ -40.0f }; x <= 40.0f; x += 20.0f)
+		{
+			for (float y{ -40.0f }; y <= 40.0f; y += 20.0f) pathSmoother.AddObstacle(Elite::Vector2{ x, y }, Elite::Vector2{ 8.0f, 8.0f });
+		}
+		// A nav mesh that snaps to a half meter grid inside the world, close to a house it hands out one of two of its corners and flips between them as the target moves like the real one does
+		PathFunctions pathFunctions{};
+		pathFunctions.pathfinding = [](const Elite::Vector2& point) -> Elite::Vector2
+			{
+				const Elite::Vector2 snapped{ std::clamp(std::round(point.x * 2.0f) * 0.5f, -50.0f, 50.0f), std::clamp(std::round(point.y * 2.0f) * 0.5f, -50.0f, 50.0f) };
+				const Elite::Vector2 house{ std::round(snapped.x / 20.0f) * 20.0f, std::round(snapped.y / 20.0f) * 20.0f };
+				if (house.DistanceSquared(snapped) > 100.0f) return snapped;
+
+				const bool otherCorner{ (int(std::round(snapped.x * 2.0f) + std::round(snapped.y * 2.0f)) % 2) == 0 };
+				return house + (otherCorner ? Elite::Vector2{ 6.0f, 6.0f } : Elite::Vector2{ -6.0f, 6.0f });
+			};
+		pathFunctions.smoothing = [&pathSmoother](Navigation::SmoothingHistory& history, const Elite::Vector2& position, const Elite::Vector2& pathPoint, const Elite::Vector2& target) -> Elite::Vector2
+			{
+				return pathSmoother.Smooth(history, position, pathPoint, target);
+			};
+
+		// Seeded agents and targets, the first agent stands on its target
+		std::mt19937 generator{ 28 };
+		std::uniform_real_distribution<float> coordinate{ -45.0f, 45.0f };
+		std::uniform_real_distribution<float> velocity{ -5.0f, 5.0f };
+		std::uniform_real_distribution<float> angle{ -float(E_PI), float(E_PI) };
+		std::uniform_real_distribution<float> linearSpeed{ 2.0f, 10.0f };
+		std::uniform_real_distribution<float> angularSpeed{ 1.0f, float(E_PI) };
+		const size_t count{ size_t(agentCount) };
+		AgentBatch batch{};
+		batch.Resize(count);
+		// The smoother remembers the path of every agent, so every agent gets its own seek and arrive like it gets its own wander
+		std::vector<std::unique_ptr<Seek>> seeks{};
+		std::vector<std::unique_ptr<Arrive>> arrives{};
+		std::vector<std::unique_ptr<Wander>> wanders{};
+		std::vector<std::array<float, 64>> angleDeltas(count);
+		for (size_t agent{}; agent < count; ++agent)
+		{
+			batch.positionX[agent] = coordinate(generator);
+			batch.positionY[agent] = coordinate(generator);
+			batch.velocityX[agent] = velocity(generator);
+			batch.velocityY[agent] = velocity(generator);
+			batch.orientation[agent] = angle(generator);
+			batch.maxLinearSpeed[agent] = linearSpeed(generator);
+			batch.maxAngularSpeed[agent] = angularSpeed(generator);
+			batch.targetPositionX[agent] = (agent == 0) ? batch.positionX[agent] : coordinate(generator);
+			batch.targetPositionY[agent] = (agent == 0) ? batch.positionY[agent] : coordinate(generator);
+			batch.targetVelocityX[agent] = velocity(generator);
+			batch.targetVelocityY[agent] = velocity(generator);
+			seeks.push_back(std::make_unique<Seek>(pathFunctions));
+			arrives.push_back(std::make_unique<Arrive>(pathFunctions));
+			wanders.push_back(std::make_unique<Wander>(pathFunctions, 6.0f, 4.0f, Elite::ToRadians(70.0f), uint32_t(agent)));
+		}
+
+		// The batch gets its wander angle changes from a second generator with the same seed, a block at a time like the single agent version
+		std::vector<std::unique_ptr<Wander>> angleGenerators{};
+		for (size_t agent{}; agent < count; ++agent) angleGenerators.push_back(std::make_unique<Wander>(pathFunctions, 6.0f, 4.0f, Elite::ToRadians(70.0f), uint32_t(agent)));
+
+		Flee flee{ pathFunctions };
+		Pursuit pursuit{ pathFunctions };
+		Evade evade{ pathFunctions };
+		const std::array<const char*, 6> names{ "seek", "flee", "arrive", "pursuit", "evade", "wander" };
+		std::array<int, 6> mismatches{};
+		std::array<std::string, 6> firstMismatches{};
+
+		// Runs one behaviour both ways and compares every output of every agent
+		float deltaTime{};
+		int frame{};
+		const auto check{ [&](size_t behaviour, auto runBatch, auto runSingle) -> void
+			{
+				runBatch();
+				for (size_t agent{}; agent < count; ++agent)
+				{
+					AgentInfo agentInfo{};
+					agentInfo.Position = Elite::Vector2{ batch.positionX[agent], batch.positionY[agent] };
+					agentInfo.LinearVelocity = Elite::Vector2{ batch.velocityX[agent], batch.velocityY[agent] };
+					agentInfo.Orientation = batch.orientation[agent];
+					agentInfo.MaxLinearSpeed = batch.maxLinearSpeed[agent];
+					agentInfo.MaxAngularSpeed = batch.maxAngularSpeed[agent];
+					const TargetData targetData{ Elite::Vector2{ batch.targetPositionX[agent], batch.targetPositionY[agent] }, Elite::Vector2{ batch.targetVelocityX[agent], batch.targetVelocityY[agent] } };
+					const SteeringPlugin_Output steering{ runSingle(agent, agentInfo, targetData) };
+
+					if (IsBitIdentical(steering.LinearVelocity.x, batch.linearVelocityX[agent]) && IsBitIdentical(steering.LinearVelocity.y, batch.linearVelocityY[agent]) && IsBitIdentical(steering.AngularVelocity, batch.angularVelocity[agent])) continue;
+					if (mismatches[behaviour]++ > 0) continue;
+
+					std::stringstream stream{};
+					stream.precision(9);
+					stream << ", first at agent " << agent << " frame " << frame << ": single " << steering.LinearVelocity << " " << steering.AngularVelocity << ", batch (" << batch.linearVelocityX[agent] << ", " << batch.linearVelocityY[agent] << ") " << batch.angularVelocity[agent];
+					firstMismatches[behaviour] = stream.str();
+				}
+			} };
+
+		for (; frame < frameCount; ++frame)
+		{
+			// Long frames now and then, those are the ones arrive and the turning have to clamp
+			deltaTime = ((frame % 7) == 6) ? 0.1f : (1.0f / 60.0f);
+			if ((frame % angleDeltas.front().size()) == 0)
+			{
+				for (size_t agent{}; agent < count; ++agent) angleGenerators[agent]->GenerateAngleDeltas(angleDeltas[agent].data(), angleDeltas[agent].size());
+			}
+			for (size_t agent{}; agent < count; ++agent) batch.angleDelta[agent] = angleDeltas[agent][size_t(frame) % angleDeltas[agent].size()];
+
+			check(0, [&]() -> void { BatchSteering::Seek(batch, pathFunctions); }, [&](size_t agent, const AgentInfo& agentInfo, const TargetData& targetData) -> SteeringPlugin_Output { return seeks[agent]->CalculateSteering(deltaTime, agentInfo, targetData); });
+			check(1, [&]() -> void { BatchSteering::Flee(batch, pathFunctions, deltaTime); }, [&](size_t, const AgentInfo& agentInfo, const TargetData& targetData) -> SteeringPlugin_Output { return flee.CalculateSteering(deltaTime, agentInfo, targetData); });
+			check(2, [&]() -> void { BatchSteering::Arrive(batch, pathFunctions, deltaTime); }, [&](size_t agent, const AgentInfo& agentInfo, const TargetData& targetData) -> SteeringPlugin_Output { return arrives[agent]->CalculateSteering(deltaTime, agentInfo, targetData); });
+			check(3, [&]() -> void { BatchSteering::Pursuit(batch, pathFunctions); }, [&](size_t, const AgentInfo& agentInfo, const TargetData& targetData) -> SteeringPlugin_Output { return pursuit.CalculateSteering(deltaTime, agentInfo, targetData); });
+			check(4, [&]() -> void { BatchSteering::Evade(batch, pathFunctions, deltaTime); }, [&](size_t, const AgentInfo& agentInfo, const TargetData& targetData) -> SteeringPlugin_Output { return evade.CalculateSteering(deltaTime, agentInfo, targetData); });
+			check(5, [&]() -> void { BatchSteering::Wander(batch, pathFunctions); }, [&](size_t agent, const AgentInfo& agentInfo, const TargetData& targetData) -> SteeringPlugin_Output { return wanders[agent]->CalculateSteering(deltaTime, agentInfo, targetData); });
+
+			// Everyone wanders on and turns a bit, the targets keep walking
+			for (size_t agent{}; agent < count; ++agent)
+			{
+				batch.velocityX[agent] = batch.linearVelocityX[agent];
+				batch.velocityY[agent] = batch.linearVelocityY[agent];
+				batch.positionX[agent] += batch.velocityX[agent] * deltaTime;
+				batch.positionY[agent] += batch.velocityY[agent] * deltaTime;
+				batch.orientation[agent] += angle(generator) * deltaTime;
+				batch.targetPositionX[agent] += batch.targetVelocityX[agent] * deltaTime;
+				batch.targetPositionY[agent] += batch.targetVelocityY[agent] * deltaTime;
+			}
+		}
+
+		std::cout << "Batch steering against the single agent behaviours, " << agentCount << " agents over " << frameCount << " frames" << std::endl;
+		for (size_t behaviour{}; behaviour < names.size(); ++behaviour)
+		{
+			if (mismatches[behaviour] == 0) std::cout << "  " << names[behaviour] << ": ok" << std::endl;
+			else std::cout << "  " << names[behaviour] << ": FAILED, " << mismatches[behaviour] << " of " << (agentCount * frameCount) << " agents differ" << firstMismatches[behaviour] << std::endl;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef BENCHMARKS
+#define BENCHMARKS
+
+// Small timing runs and checks that print their results to the console, run by the benchmark program and never by the plugin
+namespace Benchmarks
+{
+	// Remembering and looking up items and houses with the old hashes, the new hashes and the flat hash sets
+	void RunHashing(int itemCount = 500, int lookupCount = 200000);
+	// The perception part of a tick, publishing every FOV list on the blackboard for readers that search them themselves against building one perception frame
+	void RunPerception(int enemyCount = 20, int itemCount = 8, int tickCount = 100000);
+	// Hit rate and score per shot over seeded runs, for the closest enemy in a cone, turning towards the closest without lead and the target selector
+	void RunTargeting(int seedCount = 20, int enemyCount = 6, float duration = 60.0f);
+	// Mean time until we face a target and stay facing it from random bearings, turning at full speed, with the capped OrientTo and with the aim controller
+	void RunAiming(int targetCount = 1000, float maximumTargetSpeed = 3.0f);
+	// The smoother may only cut corners when neither we nor the target are inside a house, checks it keeps the nav mesh's door otherwise
+	void CheckPathSmoothing();
+	// Runs the batch steering and the single agent behaviours on the same seeded agents and reports every result that isn't bit identical
+	void CheckBatchSteering(int agentCount = 256, int frameCount = 120);
+}
+
+#endif
\ No newline at end of file
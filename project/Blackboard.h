@@ -34,10 +34,10 @@ namespace DecisionMaking
 			return *m_Data.get();
 		}
 
+		// Overwrite in place, data that changes every frame shouldn't cost an allocation every frame
 		void SetData(Type data)
 		{ 
-			m_Data.reset();
-			m_Data = std::make_unique<Type>(data);
+			*m_Data = std::move(data);
 		}
 
 	private:
@@ -75,7 +75,7 @@ namespace DecisionMaking
 			{
 				BlackboardField<Type>* pBlackBoardField{ dynamic_cast<BlackboardField<Type>*>(m_Data.at(key)) };
 
-				if (pBlackBoardField) pBlackBoardField->SetData(data);
+				if (pBlackBoardField) pBlackBoardField->SetData(std::move(data));
 				else std::cout << "Blackboard couldn't change data because of type mismatch (key: " << key << ")" << std::endl;
 			}
 			else std::cout << "Blackboard has no element with " << key << "as the key" << std::endl;
@@ -0,0 +1,157 @@
+#include "stdafx.h"
+#include "Coverage Map.h"
+#include <bit>
+#include <array>
+
+namespace Memory
+{
+	CoverageMap::CoverageMap(const WorldInfo& worldInfo, float cellSize) :
+		m_Origin{ worldInfo.Center - (worldInfo.Dimensions / 2.0f) },
+		m_CellSize{ cellSize },
+		m_Columns{ std::max(int(ceilf(worldInfo.Dimensions.x / cellSize)), 1) },
+		m_Rows{ std::max(int(ceilf(worldInfo.Dimensions.y / cellSize)), 1) },
+		m_WordsPerRow{ (m_Columns + 63) / 64 },
+		m_CoveredCount{ 0 },
+		m_Bits(size_t(m_WordsPerRow * m_Rows), 0)
+	{
+
+	}
+
+	void CoverageMap::MarkCone(const Elite::Vector2& position, float orientation, float fovAngle, float fovRange)
+	{
+		const Elite::Vector2 leftEdge{ Elite::OrientationToVector(orientation + (fovAngle / 2.0f)) };
+		const Elite::Vector2 rightEdge{ Elite::OrientationToVector(orientation - (fovAngle / 2.0f)) };
+		// A cone wider than half a circle isn't the overlap of the two half planes anymore, just take the whole circle then
+		const bool clipEdges{ fovAngle < float(E_PI) };
+
+		const int firstRow{ std::max(int(floorf((position.y - fovRange - m_Origin.y) / m_CellSize)), 0) };
+		const int lastRow{ std::min(int(floorf((position.y + fovRange - m_Origin.y) / m_CellSize)), m_Rows - 1) };
+
+		// Every row of cells is one span, the circle and both edges of the cone each cut it down
+		for (int row{ firstRow }; row <= lastRow; ++row)
+		{
+			const float offsetY{ (m_Origin.y + ((float(row) + 0.5f) * m_CellSize)) - position.y };
+			if (fabsf(offsetY) > fovRange) continue;
+
+			const float halfWidth{ sqrtf((fovRange * fovRange) - (offsetY * offsetY)) };
+			float minimumX{ -halfWidth };
+			float maximumX{ halfWidth };
+
+			if (clipEdges)
+			{
+				// Both edges as a * x >= b where x is relative to our position
+				const std::array<std::pair<float, float>, 2> halfPlanes{ std::pair{ -rightEdge.y, -rightEdge.x * offsetY }, std::pair{ leftEdge.y, leftEdge.x * offsetY } };
+				for (const auto& [a, b] : halfPlanes)
+				{
+					if (a > 0.0f) minimumX = std::max(minimumX, b / a);
+					else if (a < 0.0f) maximumX = std::min(maximumX, b / a);
+					else if (b > 0.0f) maximumX = minimumX - 1.0f;
+				}
+			}
+
+			const int firstColumn{ std::max(int(ceilf(((position.x + minimumX - m_Origin.x) / m_CellSize) - 0.5f)), 0) };
+			const int lastColumn{ std::min(int(floorf(((position.x + maximumX - m_Origin.x) / m_CellSize) - 0.5f)), m_Columns - 1) };
+			if (firstColumn <= lastColumn) MarkSpan(row, firstColumn, lastColumn);
+		}
+	}
+
+	void CoverageMap::Clear()
+	{
+		std::fill(m_Bits.begin(), m_Bits.end(), 0);
+		m_CoveredCount = 0;
+	}
+
+	bool CoverageMap::IsCovered(const Elite::Vector2& position) const
+	{
+		const int column{ std::clamp(int((position.x - m_Origin.x) / m_CellSize), 0, m_Columns - 1) };
+		const int row{ std::clamp(int((position.y - m_Origin.y) / m_CellSize), 0, m_Rows - 1) };
+		return IsCovered(column, row);
+	}
+
+	int CoverageMap::GetCoveredCount() const
+	{
+		return m_CoveredCount;
+	}
+
+	float CoverageMap::GetCoverage() const
+	{
+		return float(m_CoveredCount) / float(m_Columns * m_Rows);
+	}
+
+	bool CoverageMap::FindNearestFrontier(const Elite::Vector2& position, float minimumDistance, Elite::Vector2& frontier) const
+	{
+		const int startColumn{ std::clamp(int((position.x - m_Origin.x) / m_CellSize), 0, m_Columns - 1) };
+		const int startRow{ std::clamp(int((position.y - m_Origin.y) / m_CellSize), 0, m_Rows - 1) };
+		const float minimumDistanceSquared{ minimumDistance * minimumDistance };
+		float bestDistanceSquared{ FLT_MAX };
+
+		// Search outwards ring by ring, until no cell in the next ring can be closer than the best frontier
+		const int ringCount{ std::max(m_Columns, m_Rows) };
+		for (int ring{}; ring < ringCount; ++ring)
+		{
+			const float ringDistance{ float(ring - 1) * m_CellSize };
+			if ((ringDistance > 0.0f) && ((ringDistance * ringDistance) > bestDistanceSquared)) break;
+
+			for (int row{ startRow - ring }; row <= startRow + ring; ++row)
+			{
+				if ((row < 0) || (row >= m_Rows)) continue;
+
+				// Only the outer cells of the ring, the whole row for its top and bottom
+				const bool isEdgeRow{ (row == startRow - ring) || (row == startRow + ring) };
+				const int columnStep{ isEdgeRow ? 1 : std::max(2 * ring, 1) };
+				for (int column{ startColumn - ring }; column <= startColumn + ring; column += columnStep)
+				{
+					if ((column < 0) || (column >= m_Columns) || !IsFrontier(column, row)) continue;
+
+					const Elite::Vector2 center{ GetCellCenter(column, row) };
+					const float distanceSquared{ center.DistanceSquared(position) };
+					if ((distanceSquared >= minimumDistanceSquared) && (distanceSquared < bestDistanceSquared))
+					{
+						bestDistanceSquared = distanceSquared;
+						frontier = center;
+					}
+				}
+			}
+		}
+
+		return bestDistanceSquared != FLT_MAX;
+	}
+
+	void CoverageMap::MarkSpan(int row, int firstColumn, int lastColumn)
+	{
+		uint64_t* pRow{ m_Bits.data() + (row * m_WordsPerRow) };
+		const int firstWord{ firstColumn / 64 };
+		const int lastWord{ lastColumn / 64 };
+
+		// Whole words at once, only the first and last word of the span need a partial mask
+		for (int word{ firstWord }; word <= lastWord; ++word)
+		{
+			uint64_t mask{ ~uint64_t{} };
+			if (word == firstWord) mask &= ~uint64_t{} << (firstColumn % 64);
+			if (word == lastWord) mask &= ~uint64_t{} >> (63 - (lastColumn % 64));
+
+			m_CoveredCount += std::popcount(mask & ~pRow[word]);
+			pRow[word] |= mask;
+		}
+	}
+
+	bool CoverageMap::IsCovered(int column, int row) const
+	{
+		return (m_Bits[size_t((row * m_WordsPerRow) + (column / 64))] >> (column % 64)) & 1;
+	}
+
+	bool CoverageMap::IsFrontier(int column, int row) const
+	{
+		if (IsCovered(column, row)) return false;
+
+		return ((column > 0) && IsCovered(column - 1, row))
+			|| ((column < m_Columns - 1) && IsCovered(column + 1, row))
+			|| ((row > 0) && IsCovered(column, row - 1))
+			|| ((row < m_Rows - 1) && IsCovered(column, row + 1));
+	}
+
+	Elite::Vector2 CoverageMap::GetCellCenter(int column, int row) const
+	{
+		return Elite::Vector2{ m_Origin.x + ((float(column) + 0.5f) * m_CellSize), m_Origin.y + ((float(row) + 0.5f) * m_CellSize) };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef COVERAGE_MAP
+#define COVERAGE_MAP
+
+#include "Exam_HelperStructs.h"
+#include <vector>
+#include <cstdint>
+
+namespace Memory
+{
+	// One bit per cell of the world, set once the cell was inside our field of view
+	class CoverageMap final
+	{
+	public:
+		CoverageMap(const WorldInfo& worldInfo, float cellSize = 4.0f);
+		~CoverageMap() = default;
+
+		CoverageMap(const CoverageMap&) = delete;
+		CoverageMap& operator=(const CoverageMap&) = delete;
+		CoverageMap(CoverageMap&&) = delete;
+		CoverageMap& operator=(CoverageMap&&) = delete;
+
+		// Marks every cell with its center inside the cone, the angle is the full opening angle in radians
+		void MarkCone(const Elite::Vector2& position, float orientation, float fovAngle, float fovRange);
+		// Forgets everything we saw, a new wave spawns items where we already looked
+		void Clear();
+
+		bool IsCovered(const Elite::Vector2& position) const;
+		int GetCoveredCount() const;
+		// Fraction of the cells we have seen, between 0 and 1
+		float GetCoverage() const;
+		// Nearest cell we haven't seen next to one we have, at least minimumDistance away, false if there is none
+		bool FindNearestFrontier(const Elite::Vector2& position, float minimumDistance, Elite::Vector2& frontier) const;
+
+	private:
+		Elite::Vector2 m_Origin;
+		float m_CellSize;
+		int m_Columns;
+		int m_Rows;
+		int m_WordsPerRow;
+		int m_CoveredCount;
+		std::vector<uint64_t> m_Bits;
+
+		void MarkSpan(int row, int firstColumn, int lastColumn);
+		bool IsCovered(int column, int row) const;
+		bool IsFrontier(int column, int row) const;
+		Elite::Vector2 GetCellCenter(int column, int row) const;
+	};
+}
+
+#endif
\ No newline at end of file
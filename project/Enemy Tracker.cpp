@@ -0,0 +1,172 @@
+#include "stdafx.h"
+#include "Enemy Tracker.h"
+
+namespace Memory
+{
+	EnemyTracker::EnemyTracker(float timeOut, float maximumPredictionTime) :
+		m_TimeOut{ timeOut },
+		m_MaximumPredictionTime{ maximumPredictionTime },
+		m_Count{ 0 },
+		m_Tracks{ Capacity * 2 },
+		m_EnemyHashes{},
+		m_Types{},
+		m_Sizes{},
+		m_Ages{},
+		m_PositionsX{},
+		m_PositionsY{},
+		m_VelocitiesX{},
+		m_VelocitiesY{},
+		m_HistoryHeads{},
+		m_HistoryCounts{},
+		m_HistoryPositionsX{},
+		m_HistoryPositionsY{},
+		m_HistoryVelocitiesX{},
+		m_HistoryVelocitiesY{}
+	{
+
+	}
+
+	void EnemyTracker::Update(float deltaTime, std::span<const EnemyInfo> sightings)
+	{
+		// Dead reckoning, keep moving every track along its last velocity for a while
+		for (size_t track{}; track < m_Count; ++track)
+		{
+			const float predictionTime{ std::clamp(m_MaximumPredictionTime - m_Ages[track], 0.0f, deltaTime) };
+			m_PositionsX[track] += m_VelocitiesX[track] * predictionTime;
+			m_PositionsY[track] += m_VelocitiesY[track] * predictionTime;
+			m_Ages[track] += deltaTime;
+		}
+
+		// Sightings replace the guesses and go into the history
+		std::ranges::for_each(sightings, [this](const EnemyInfo& enemy) -> void
+			{
+				const int* pTrack{ m_Tracks.Find(enemy.EnemyHash) };
+				const size_t track{ (pTrack != nullptr) ? size_t(*pTrack) : AddTrack(enemy) };
+
+				m_Types[track] = enemy.Type;
+				m_Sizes[track] = enemy.Size;
+				m_Ages[track] = 0.0f;
+				m_PositionsX[track] = enemy.Location.x;
+				m_PositionsY[track] = enemy.Location.y;
+				m_VelocitiesX[track] = enemy.LinearVelocity.x;
+				m_VelocitiesY[track] = enemy.LinearVelocity.y;
+
+				m_HistoryHeads[track] = static_cast<unsigned char>((m_HistoryHeads[track] + 1) % HistorySize);
+				m_HistoryCounts[track] = static_cast<unsigned char>(std::min(size_t(m_HistoryCounts[track]) + 1, HistorySize));
+				const size_t historyIndex{ GetHistoryIndex(track, 0) };
+				m_HistoryPositionsX[historyIndex] = enemy.Location.x;
+				m_HistoryPositionsY[historyIndex] = enemy.Location.y;
+				m_HistoryVelocitiesX[historyIndex] = enemy.LinearVelocity.x;
+				m_HistoryVelocitiesY[historyIndex] = enemy.LinearVelocity.y;
+			});
+
+		// Forget the enemies we lost track of
+		for (size_t track{}; track < m_Count;)
+		{
+			if (m_Ages[track] > m_TimeOut) RemoveTrack(track);
+			else ++track;
+		}
+	}
+
+	size_t EnemyTracker::GetCount() const
+	{
+		return m_Count;
+	}
+
+	int EnemyTracker::FindTrack(int enemyHash) const
+	{
+		const int* pTrack{ m_Tracks.Find(enemyHash) };
+		return (pTrack != nullptr) ? *pTrack : -1;
+	}
+
+	int EnemyTracker::GetEnemyHash(size_t track) const
+	{
+		return m_EnemyHashes[track];
+	}
+
+	eEnemyType EnemyTracker::GetType(size_t track) const
+	{
+		return m_Types[track];
+	}
+
+	float EnemyTracker::GetSize(size_t track) const
+	{
+		return m_Sizes[track];
+	}
+
+	float EnemyTracker::GetAge(size_t track) const
+	{
+		return m_Ages[track];
+	}
+
+	Elite::Vector2 EnemyTracker::GetPosition(size_t track) const
+	{
+		return Elite::Vector2{ m_PositionsX[track], m_PositionsY[track] };
+	}
+
+	Elite::Vector2 EnemyTracker::GetVelocity(size_t track) const
+	{
+		return Elite::Vector2{ m_VelocitiesX[track], m_VelocitiesY[track] };
+	}
+
+	Elite::Vector2 EnemyTracker::GetHistoryPosition(size_t track, size_t framesAgo) const
+	{
+		const size_t historyIndex{ GetHistoryIndex(track, framesAgo) };
+		return Elite::Vector2{ m_HistoryPositionsX[historyIndex], m_HistoryPositionsY[historyIndex] };
+	}
+
+	Elite::Vector2 EnemyTracker::GetHistoryVelocity(size_t track, size_t framesAgo) const
+	{
+		const size_t historyIndex{ GetHistoryIndex(track, framesAgo) };
+		return Elite::Vector2{ m_HistoryVelocitiesX[historyIndex], m_HistoryVelocitiesY[historyIndex] };
+	}
+
+	size_t EnemyTracker::AddTrack(const EnemyInfo& enemy)
+	{
+		// When we are full the enemy we haven't seen for the longest time makes room
+		if (m_Count == Capacity)
+		{
+			RemoveTrack(size_t(std::distance(std::begin(m_Ages), std::max_element(std::begin(m_Ages), std::end(m_Ages)))));
+		}
+
+		const size_t track{ m_Count++ };
+		m_EnemyHashes[track] = enemy.EnemyHash;
+		m_HistoryHeads[track] = 0;
+		m_HistoryCounts[track] = 0;
+		m_Tracks.Insert(enemy.EnemyHash, int(track));
+
+		return track;
+	}
+
+	void EnemyTracker::RemoveTrack(size_t track)
+	{
+		// Move the last track into the hole so the tracks stay packed
+		m_Tracks.Erase(m_EnemyHashes[track]);
+
+		const size_t last{ --m_Count };
+		if (track == last) return;
+
+		m_EnemyHashes[track] = m_EnemyHashes[last];
+		m_Types[track] = m_Types[last];
+		m_Sizes[track] = m_Sizes[last];
+		m_Ages[track] = m_Ages[last];
+		m_PositionsX[track] = m_PositionsX[last];
+		m_PositionsY[track] = m_PositionsY[last];
+		m_VelocitiesX[track] = m_VelocitiesX[last];
+		m_VelocitiesY[track] = m_VelocitiesY[last];
+		m_HistoryHeads[track] = m_HistoryHeads[last];
+		m_HistoryCounts[track] = m_HistoryCounts[last];
+		std::copy_n(std::begin(m_HistoryPositionsX) + (last * HistorySize), HistorySize, std::begin(m_HistoryPositionsX) + (track * HistorySize));
+		std::copy_n(std::begin(m_HistoryPositionsY) + (last * HistorySize), HistorySize, std::begin(m_HistoryPositionsY) + (track * HistorySize));
+		std::copy_n(std::begin(m_HistoryVelocitiesX) + (last * HistorySize), HistorySize, std::begin(m_HistoryVelocitiesX) + (track * HistorySize));
+		std::copy_n(std::begin(m_HistoryVelocitiesY) + (last * HistorySize), HistorySize, std::begin(m_HistoryVelocitiesY) + (track * HistorySize));
+
+		*m_Tracks.Find(m_EnemyHashes[track]) = int(track);
+	}
+
+	size_t EnemyTracker::GetHistoryIndex(size_t track, size_t framesAgo) const
+	{
+		const size_t steps{ std::min(framesAgo, size_t(std::max(int(m_HistoryCounts[track]) - 1, 0))) };
+		return (track * HistorySize) + ((m_HistoryHeads[track] + HistorySize - steps) % HistorySize);
+	}
+}
\ No newline at end of file
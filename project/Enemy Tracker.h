@@ -0,0 +1,74 @@
+#ifndef ENEMY_TRACKER
+#define ENEMY_TRACKER
+
+#include "Exam_HelperStructs.h"
+#include "Flat Hash Map.h"
+#include <array>
+#include <vector>
+#include <span>
+
+namespace Memory
+{
+	// Remembers the enemies we saw by their hash and guesses where the ones we don't see anymore are now
+	class EnemyTracker final
+	{
+	public:
+		static constexpr size_t Capacity{ 256 };
+		static constexpr size_t HistorySize{ 8 };
+
+		EnemyTracker(float timeOut = 8.0f, float maximumPredictionTime = 3.0f);
+		~EnemyTracker() = default;
+
+		EnemyTracker(const EnemyTracker&) = delete;
+		EnemyTracker& operator=(const EnemyTracker&) = delete;
+		EnemyTracker(EnemyTracker&&) = delete;
+		EnemyTracker& operator=(EnemyTracker&&) = delete;
+
+		// Moves the unseen enemies along, stores this frame's sightings and forgets enemies we haven't seen for too long
+		void Update(float deltaTime, std::span<const EnemyInfo> sightings);
+
+		// Tracks are indexed 0 to GetCount() - 1, indices change when tracks expire
+		size_t GetCount() const;
+		int FindTrack(int enemyHash) const;
+		int GetEnemyHash(size_t track) const;
+		eEnemyType GetType(size_t track) const;
+		float GetSize(size_t track) const;
+		// Seconds since we last saw it, 0 means it is in our field of view
+		float GetAge(size_t track) const;
+		Elite::Vector2 GetPosition(size_t track) const;
+		Elite::Vector2 GetVelocity(size_t track) const;
+		// Where we saw it framesAgo sightings ago, the last one we have if there aren't that many
+		Elite::Vector2 GetHistoryPosition(size_t track, size_t framesAgo) const;
+		Elite::Vector2 GetHistoryVelocity(size_t track, size_t framesAgo) const;
+
+	private:
+		float m_TimeOut;
+		float m_MaximumPredictionTime;
+		size_t m_Count;
+		Containers::FlatHashMap<int, int> m_Tracks;
+
+		// One element per track
+		std::array<int, Capacity> m_EnemyHashes;
+		std::array<eEnemyType, Capacity> m_Types;
+		std::array<float, Capacity> m_Sizes;
+		std::array<float, Capacity> m_Ages;
+		std::array<float, Capacity> m_PositionsX;
+		std::array<float, Capacity> m_PositionsY;
+		std::array<float, Capacity> m_VelocitiesX;
+		std::array<float, Capacity> m_VelocitiesY;
+
+		// HistorySize elements per track, a ring buffer that starts at the head of the track
+		std::array<unsigned char, Capacity> m_HistoryHeads;
+		std::array<unsigned char, Capacity> m_HistoryCounts;
+		std::array<float, Capacity * HistorySize> m_HistoryPositionsX;
+		std::array<float, Capacity * HistorySize> m_HistoryPositionsY;
+		std::array<float, Capacity * HistorySize> m_HistoryVelocitiesX;
+		std::array<float, Capacity * HistorySize> m_HistoryVelocitiesY;
+
+		size_t AddTrack(const EnemyInfo& enemy);
+		void RemoveTrack(size_t track);
+		size_t GetHistoryIndex(size_t track, size_t framesAgo) const;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -1,13 +1,15 @@
 #include "stdafx.h"
 #include "FSM Conditions.h"
 #include "Exam_HelperStructs.h"
+#include "Perception.h"
 #include "Blackboard.h"
+#include "House Registry.h"
+#include "Inventory.h"
+#include "Inventory Optimizer.h"
 #include <unordered_map>
-#include <unordered_set>
 #include <ranges>
 #include <algorithm>
 #include <array>
-#include <tuple>
 
 namespace DecisionMaking
 {
@@ -60,28 +62,34 @@ namespace DecisionMaking
 			FOVStats fovStats{};
 			pBlackboard->GetData("FOVStats", fovStats);
 
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
+
 			// Do we see houses
 			if (fovStats.NumHouses > 0)
 			{
-				std::vector<HouseInfo> houses{};
-				pBlackboard->GetData("Houses", houses);
-
-				std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-				pBlackboard->GetData("FoundHouses", foundHouses);
+				PerceptionFrame* pPerception{};
+				pBlackboard->GetData("Perception", pPerception);
+				const HousesInFOV& houses{ pPerception->Houses };
 
 				// Do we see an unexplored house
-				output = std::ranges::any_of(houses, [foundHouses](const HouseInfo& house) -> bool 
+				output = std::ranges::any_of(houses, [pHouseRegistry](const HouseInfo& house) -> bool 
 					{ 
-						// We already found the house but maybe we didn't explore it yet
-						if (foundHouses->contains(house))
-						{
-							return !std::get<0>(foundHouses->at(house));
-						}
-						// This is a completly new house
-						else return true;
+						// A completly new house, or one we already found but maybe didn't explore yet
+						const int id{ pHouseRegistry->Find(house) };
+						return (id == Memory::HouseRegistry::InvalidId) || !pHouseRegistry->IsExplored(id);
 					});
 			}
 
+			// Otherwise go to an unexplored house we saw before instead of wandering around
+			if (!output)
+			{
+				AgentInfo agentInfo{};
+				pBlackboard->GetData("AgentInfo", agentInfo);
+
+				output = pHouseRegistry->FindNearestUnexplored(agentInfo.Position) != Memory::HouseRegistry::InvalidId;
+			}
+
 			return output;
 		}
 
@@ -89,20 +97,17 @@ namespace DecisionMaking
 		{
 			bool output{ true };
 
-			HouseInfo* currentHouse{};
+			int currentHouse{};
 			pBlackboard->GetData("CurrentHouse", currentHouse);
 
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
+
 			AgentInfo agentInfo{};
 			pBlackboard->GetData("AgentInfo", agentInfo);
 
 			// Check if we are outside the house
-			if (currentHouse != nullptr)
-			{
-				if (agentInfo.Position.x > (currentHouse->Center.x + (currentHouse->Size.x / 2.0f))) output = false;
-				else if (agentInfo.Position.x < (currentHouse->Center.x - (currentHouse->Size.x / 2.0f))) output = false;
-				else if (agentInfo.Position.y > (currentHouse->Center.y + (currentHouse->Size.y / 2.0f))) output = false;
-				else if (agentInfo.Position.y < (currentHouse->Center.y - (currentHouse->Size.y / 2.0f))) output = false;
-			}
+			if (currentHouse != Memory::HouseRegistry::InvalidId) output = pHouseRegistry->Contains(currentHouse, agentInfo.Position);
 			else output = false;
 
 			return output;
@@ -112,16 +117,18 @@ namespace DecisionMaking
 		{
 			bool output{ false };
 
-			FOVStats fovStats{};
-			pBlackboard->GetData("FOVStats", fovStats);
+			PerceptionFrame* pPerception{};
+			pBlackboard->GetData("Perception", pPerception);
 
-			std::vector<ItemInfo>* inventory{};
-			pBlackboard->GetData("Inventory", inventory);
+			Memory::Inventory* pInventory{};
+			pBlackboard->GetData("Inventory", pInventory);
 
-			auto itEmptySlot{ std::ranges::find_if(*inventory, [](const ItemInfo& item) -> bool { return item.Type == eItemType::GARBAGE; }) };
+			InventoryOptimizer* pInventoryOptimizer{};
+			pBlackboard->GetData("InventoryOptimizer", pInventoryOptimizer);
 
-			// Do we see items and do we still have space left in our inventory
-			output = (fovStats.NumItems) > 0 && (itEmptySlot != std::end(*inventory));
+			// Do we see items and do we still have space left in our inventory, or is one of them worth swapping for something we carry
+			InventoryOptimizer::Action action{};
+			output = !pPerception->Items.empty() && (pInventory->HasEmptySlot() || pInventoryOptimizer->FindBestAction(*pInventory, pPerception->Items, pPerception->Stats.Difficulty, action));
 
 			return output;
 		}
@@ -130,14 +137,8 @@ namespace DecisionMaking
 		{
 			bool output{ false };
 
-			std::vector<ItemInfo>* inventory{};
-			pBlackboard->GetData("Inventory", inventory);
-
-			ItemInfo* targetItem{};
-			pBlackboard->GetData("TargetItem", targetItem);
-
-			// Do we have our target item in our inventory
-			output = std::ranges::any_of(*inventory, [&targetItem](const ItemInfo& item) -> bool { return item.ItemHash == targetItem->ItemHash; });
+			// Did we pick up or destroy our target item
+			pBlackboard->GetData("TargetItemHandled", output);
 
 			return output;
 		}
@@ -146,19 +147,19 @@ namespace DecisionMaking
 		{
 			bool output{ false };
 
-			HouseInfo* currentHouse{};
+			int currentHouse{};
 			pBlackboard->GetData("CurrentHouse", currentHouse);
 
-			std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-			pBlackboard->GetData("FoundHouses", foundHouses);
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
 
-			std::array<std::pair<bool, Elite::Vector2>, 4>* path{};
+			std::pair<int, std::vector<std::pair<bool, Elite::Vector2>>>* path{};
 			pBlackboard->GetData("InHousePath", path);
 
-			bool pathCompleted{ std::ranges::all_of(*path, [](const std::pair<bool, Elite::Vector2>& point) -> bool { return point.first; })};
+			bool pathCompleted{ std::ranges::all_of(path->second, [](const std::pair<bool, Elite::Vector2>& point) -> bool { return point.first; })};
 
 			// Do we have no items left in our current house (that we know of) and did we complete the our explore path of the house
-			output = (std::get<2>(foundHouses->at(*currentHouse)).size() == 0) && (pathCompleted);
+			output = pHouseRegistry->GetItems(currentHouse).empty() && (pathCompleted);
 
 			return output;
 		}
@@ -170,14 +171,14 @@ namespace DecisionMaking
 			AgentInfo agentInfo{};
 			pBlackboard->GetData("AgentInfo", agentInfo);
 
-			HouseInfo* currentHouse{};
+			int currentHouse{};
 			pBlackboard->GetData("CurrentHouse", currentHouse);
 
-			std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-			pBlackboard->GetData("FoundHouses", foundHouses);
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
 
 			// Are we at the entrance of the current house
-			output = agentInfo.Position.Distance(std::get<1>(foundHouses->at(*currentHouse))) < 2.0f;
+			output = agentInfo.Position.Distance(pHouseRegistry->GetEntrance(currentHouse)) < 2.0f;
 
 			return output;
 		}
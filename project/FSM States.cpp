@@ -4,12 +4,89 @@
 #include "Movement Behaviours.h"
 #include "IExamInterface.h"
 #include "Exam_HelperStructs.h"
+#include "Perception.h"
+#include "House Registry.h"
+#include "Enemy Tracker.h"
+#include "Threat Map.h"
+#include "Coverage Map.h"
+#include "Zone Registry.h"
+#include "Item Memory.h"
+#include "Flat Hash Map.h"
+#include "Inventory.h"
+#include "Inventory Optimizer.h"
+#include "Navigation Grid.h"
+#include "Path Planner.h"
+#include "Path Scheduler.h"
+#include "Flow Field.h"
+#include "Tour Optimizer.h"
+#include "Sweep Planner.h"
 #include <utility>
 #include <map>
-#include <unordered_set>
 #include <unordered_map>
 #include <array>
-#include <tuple>
+
+namespace
+{
+	// Replace the path request to the safe point with a new one
+	void RequestSafePointPath(DecisionMaking::Blackboard* pBlackboard, const Elite::Vector2& start, const Elite::Vector2& safePoint)
+	{
+		Navigation::PathScheduler* pScheduler{};
+		pBlackboard->GetData("PathScheduler", pScheduler);
+
+		std::pair<unsigned int, std::vector<Elite::Vector2>>* pSafePointPath{};
+		pBlackboard->GetData("SafePointPath", pSafePointPath);
+
+		pScheduler->Cancel(pSafePointPath->first);
+		pSafePointPath->first = pScheduler->Request(start, safePoint);
+		pSafePointPath->second.clear();
+	}
+
+	// Where to steer to on our way to the safe point, straight at it until the path is ready
+	Elite::Vector2 GetSafePointTarget(DecisionMaking::Blackboard* pBlackboard, const Elite::Vector2& position, const Elite::Vector2& safePoint)
+	{
+		Navigation::PathScheduler* pScheduler{};
+		pBlackboard->GetData("PathScheduler", pScheduler);
+
+		std::pair<unsigned int, std::vector<Elite::Vector2>>* pSafePointPath{};
+		pBlackboard->GetData("SafePointPath", pSafePointPath);
+
+		if ((pSafePointPath->first != 0) && (pScheduler->Poll(pSafePointPath->first, pSafePointPath->second) != Navigation::PathStatus::Searching)) pSafePointPath->first = 0;
+		if (pSafePointPath->second.empty()) return safePoint;
+
+		return Navigation::GetLookAheadPoint(pSafePointPath->second, position, 2);
+	}
+
+	// Point with the least zombies on a circle around center outside every zone we know, further out when the whole circle is in zones
+	Elite::Vector2 FindSafePoint(DecisionMaking::Blackboard* pBlackboard, const Elite::Vector2& center, float radius, const Elite::Vector2& preferred)
+	{
+		Memory::ThreatMap* pThreatMap{};
+		pBlackboard->GetData("ThreatMap", pThreatMap);
+
+		Memory::ZoneRegistry* pZoneRegistry{};
+		pBlackboard->GetData("ZoneRegistry", pZoneRegistry);
+
+		Elite::Vector2 safePoint{ preferred };
+		for (int ring{ 1 }; ring <= 3; ++ring)
+		{
+			safePoint = pThreatMap->FindSafestPoint(center, radius * float(ring), preferred, pZoneRegistry);
+			if (!pZoneRegistry->ContainsPoint(safePoint, 5.0f)) break;
+		}
+
+		return safePoint;
+	}
+
+	// Every zone we know is dangerous, also the ones we don't see anymore
+	void AddZoneDangers(DecisionMaking::Blackboard* pBlackboard, MovementBehavior::ContextSteering* pContextSteering, const Elite::Vector2& position)
+	{
+		Memory::ZoneRegistry* pZoneRegistry{};
+		pBlackboard->GetData("ZoneRegistry", pZoneRegistry);
+
+		for (size_t zone{}; zone < pZoneRegistry->GetCount(); ++zone)
+		{
+			pContextSteering->AddDanger(position, pZoneRegistry->GetCenter(zone), pZoneRegistry->GetRadius(zone));
+		}
+	}
+}
 
 namespace DecisionMaking
 {
@@ -28,14 +105,14 @@ namespace DecisionMaking
 
 		void Escape::Update(Blackboard* pBlackboard, float deltaTime) const
 		{
-			FOVStats fovStats{};
-			pBlackboard->GetData("FOVStats", fovStats);
+			PerceptionFrame* pPerception{};
+			pBlackboard->GetData("Perception", pPerception);
 
 			std::pair<float, float>* escapeTimer{};
 			pBlackboard->GetData("EscapeTimer", escapeTimer);
 
 			// If we don't see enemies run in the oppiste direction of the last one we saw for a set time
-			if (fovStats.NumEnemies == 0)
+			if (pPerception->Enemies.empty())
 			{
 				if (escapeTimer->first == 0.0f)
 				{
@@ -57,22 +134,43 @@ namespace DecisionMaking
 				AgentInfo agentInfo{};
 				pBlackboard->GetData("AgentInfo", agentInfo);
 
-				std::vector<EnemyInfo> enemies{};
-				pBlackboard->GetData("Enemies", enemies);
+				const EnemiesInFOV& enemies{ pPerception->Enemies };
+				const HousesInFOV& houses{ pPerception->Houses };
+				const EnemyInfo* pClosestEnemy{ pPerception->GetClosestEnemy() };
 
 				MovementBehavior::ISteeringBehavior* pFlee{};
 				pBlackboard->GetData("Flee", pFlee);
 
-				auto itClosestEnemy{ std::ranges::min_element(enemies, [&agentInfo](const EnemyInfo& enemy1, const EnemyInfo& enemy2) -> bool
-						{
-							return agentInfo.Position.DistanceSquared(enemy1.Location) < agentInfo.Position.DistanceSquared(enemy2.Location);
-						}
-				) };
+				MovementBehavior::ContextSteering* pContextSteering{};
+				pBlackboard->GetData("ContextSteering", pContextSteering);
+
+				// Every enemy and house wall we see is dangerous, we are interested in getting away from the closest enemy
+				std::ranges::for_each(enemies, [pContextSteering, &agentInfo](const EnemyInfo& enemy) -> void { pContextSteering->AddDanger(agentInfo.Position, enemy.Location, enemy.Size); });
+				std::ranges::for_each(houses, [pContextSteering, &agentInfo](const HouseInfo& house) -> void { pContextSteering->AddDangerRectangle(agentInfo.Position, house.Center, house.Size, 0.5f); });
+
+				// Zombies that just left our view are still around somewhere, less dangerous the longer ago we saw them
+				Memory::EnemyTracker* pEnemyTracker{};
+				pBlackboard->GetData("EnemyTracker", pEnemyTracker);
+				for (size_t track{}; track < pEnemyTracker->GetCount(); ++track)
+				{
+					const float age{ pEnemyTracker->GetAge(track) };
+					if (age > 0.0f) pContextSteering->AddDanger(agentInfo.Position, pEnemyTracker->GetPosition(track), pEnemyTracker->GetSize(track), 1.0f / (1.0f + age));
+				}
+
+				Navigation::FlowField* pFlowField{};
+				pBlackboard->GetData("SafetyFlowField", pFlowField);
 
-				MovementBehavior::TargetData targetData{ itClosestEnemy->Location, itClosestEnemy->LinearVelocity };
+				// Follow the flow field away from all known danger, away from the closest enemy if it has nothing for us yet
+				Elite::Vector2 fleeDirection{ pFlowField->GetDirection(agentInfo.Position) };
+				if (fleeDirection == Elite::Vector2{}) fleeDirection = (agentInfo.Position - pClosestEnemy->Location).GetNormalized();
+				const Elite::Vector2 fleePoint{ agentInfo.Position + (fleeDirection * 6.0f) };
+
+				MovementBehavior::TargetData targetData{ pClosestEnemy->Location, pClosestEnemy->LinearVelocity };
 				SteeringPlugin_Output steeringOutput{ pFlee->CalculateSteering(deltaTime, agentInfo, targetData) };
+				SteeringPlugin_Output contextOutput{ pContextSteering->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ fleePoint, Elite::Vector2{} }) };
 
-				pSteering->LinearVelocity = steeringOutput.LinearVelocity;
+				// Move using the context map but keep looking at the closest enemy
+				pSteering->LinearVelocity = contextOutput.LinearVelocity;
 				pSteering->AngularVelocity = steeringOutput.AngularVelocity;
 				pSteering->AutoOrient = steeringOutput.AutoOrient;
 
@@ -98,6 +196,10 @@ namespace DecisionMaking
 			pBlackboard->GetData("SteeringOutput", pSteering);
 
 			pSteering->RunMode = false;
+
+			std::pair<bool, Elite::Vector2>* pRoamTarget{};
+			pBlackboard->GetData("RoamTarget", pRoamTarget);
+			pRoamTarget->first = false;
 		}
 
 		void Roam::Update(Blackboard* pBlackboard, float deltaTime) const
@@ -105,15 +207,86 @@ namespace DecisionMaking
 			AgentInfo agentInfo{};
 			pBlackboard->GetData("AgentInfo", agentInfo);
 
-			MovementBehavior::ISteeringBehavior* pWander{};
-			pBlackboard->GetData("Wander", pWander);
-
 			SteeringPlugin_Output* pSteering{};
 			pBlackboard->GetData("SteeringOutput", pSteering);
 
-			// Calculate the steering
-			MovementBehavior::TargetData targetData{};
-			SteeringPlugin_Output steeringOutput{ pWander->CalculateSteering(deltaTime, agentInfo, targetData) };
+			Memory::CoverageMap* pCoverageMap{};
+			pBlackboard->GetData("CoverageMap", pCoverageMap);
+
+			std::pair<bool, Elite::Vector2>* pRoamTarget{};
+			pBlackboard->GetData("RoamTarget", pRoamTarget);
+
+			Memory::Inventory* pInventory{};
+			pBlackboard->GetData("Inventory", pInventory);
+
+			Memory::ItemMemory* pItemMemory{};
+			pBlackboard->GetData("ItemMemory", pItemMemory);
+
+			Containers::FlatHashSet<int>* pCheckedItems{};
+			pBlackboard->GetData("CheckedItems", pCheckedItems);
+
+			// With room in our inventory a useful item we left behind at most 10 seconds away makes its house worth exploring again
+			// Only the first time we consider the item, after that its house was reopened already or it isn't in one
+			const bool hasEmptySlot{ pInventory->HasEmptySlot() };
+			const float maximumDistance{ agentInfo.MaxLinearSpeed * 10.0f };
+			ItemInfo rememberedItem{};
+			if (hasEmptySlot && (pItemMemory->FindClosestLoadedWeapon(agentInfo.Position, maximumDistance, rememberedItem)
+				|| pItemMemory->FindClosest(eItemType::MEDKIT, agentInfo.Position, maximumDistance, 1, rememberedItem)
+				|| pItemMemory->FindClosest(eItemType::FOOD, agentInfo.Position, maximumDistance, 1, rememberedItem))
+				&& pCheckedItems->Insert(rememberedItem.ItemHash))
+			{
+				Memory::HouseRegistry* pHouseRegistry{};
+				pBlackboard->GetData("HouseRegistry", pHouseRegistry);
+
+				std::vector<int>* pHouses{};
+				pBlackboard->GetData("HouseQueryResults", pHouses);
+				pHouses->clear();
+				pHouseRegistry->QueryRadius(rememberedItem.Location, 1.0f, *pHouses);
+				std::ranges::for_each(*pHouses, [pHouseRegistry, &rememberedItem](int id) -> void
+					{
+						if (pHouseRegistry->Contains(id, rememberedItem.Location)) pHouseRegistry->SetExplored(id, false);
+					});
+			}
+
+			// Go to the nearest part of the world we haven't seen yet, a new one as soon as we see the old one
+			if (!pRoamTarget->first || pCoverageMap->IsCovered(pRoamTarget->second))
+			{
+				pRoamTarget->first = pCoverageMap->FindNearestFrontier(agentInfo.Position, 10.0f, pRoamTarget->second);
+			}
+
+			// Calculate the steering, we only wander when we have seen everything
+			SteeringPlugin_Output steeringOutput{};
+			if (pRoamTarget->first)
+			{
+				MovementBehavior::ContextSteering* pContextSteering{};
+				pBlackboard->GetData("ContextSteering", pContextSteering);
+
+				PerceptionFrame* pPerception{};
+				pBlackboard->GetData("Perception", pPerception);
+				const HousesInFOV& houses{ pPerception->Houses };
+
+				std::ranges::for_each(houses, [pContextSteering, &agentInfo](const HouseInfo& house) -> void { pContextSteering->AddDangerRectangle(agentInfo.Position, house.Center, house.Size, 0.5f); });
+				AddZoneDangers(pBlackboard, pContextSteering, agentInfo.Position);
+				steeringOutput = pContextSteering->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ pRoamTarget->second, Elite::Vector2{} });
+			}
+			else
+			{
+				MovementBehavior::ISteeringBehavior* pWander{};
+				pBlackboard->GetData("Wander", pWander);
+
+				MovementBehavior::TargetData targetData{};
+				steeringOutput = pWander->CalculateSteering(deltaTime, agentInfo, targetData);
+			}
+
+			// Don't wander into a place where we saw zombies lately, head for the safest point around us instead
+			Memory::ThreatMap* pThreatMap{};
+			pBlackboard->GetData("ThreatMap", pThreatMap);
+			const Elite::Vector2 ahead{ agentInfo.Position + (steeringOutput.LinearVelocity.GetNormalized() * 15.0f) };
+			if (pThreatMap->IsDangerous(ahead))
+			{
+				const Elite::Vector2 safestPoint{ pThreatMap->FindSafestPoint(agentInfo.Position, 25.0f, ahead) };
+				steeringOutput.LinearVelocity = (safestPoint - agentInfo.Position).GetNormalized() * steeringOutput.LinearVelocity.Magnitude();
+			}
 
 			// Adapt the steering variable in our blackboard
 			pSteering->AngularVelocity = steeringOutput.AngularVelocity;
@@ -182,9 +355,11 @@ namespace DecisionMaking
 			Elite::Vector2* safePoint{};
 			pBlackboard->GetData("SafePoint", safePoint);
 
-			// Set our safe point to a a point a set distance from where we are now going (direction)
+			// Set our safe point to the point a set distance away with the least zombies around, preferably where we are now going (direction)
 			const Elite::Vector2 direction{ agentInfo.LinearVelocity.GetNormalized() };
-			*safePoint = pInterface->NavMesh_GetClosestPathPoint(agentInfo.Position + (direction * 25.0f));
+			*safePoint = pInterface->NavMesh_GetClosestPathPoint(FindSafePoint(pBlackboard, agentInfo.Position, 25.0f, agentInfo.Position + (direction * 25.0f)));
+
+			RequestSafePointPath(pBlackboard, agentInfo.Position, *safePoint);
 		}
 
 		void SafeSeek::Update(Blackboard* pBlackboard, float deltaTime) const
@@ -192,8 +367,8 @@ namespace DecisionMaking
 			SteeringPlugin_Output* pSteering{};
 			pBlackboard->GetData("SteeringOutput", pSteering);
 
-			MovementBehavior::ISteeringBehavior* pSeek;
-			pBlackboard->GetData("Seek", pSeek);
+			MovementBehavior::ContextSteering* pContextSteering{};
+			pBlackboard->GetData("ContextSteering", pContextSteering);
 
 			AgentInfo agentInfo{};
 			pBlackboard->GetData("AgentInfo", agentInfo);
@@ -201,8 +376,17 @@ namespace DecisionMaking
 			Elite::Vector2* safePoint{};
 			pBlackboard->GetData("SafePoint", safePoint);
 
+			PerceptionFrame* pPerception{};
+			pBlackboard->GetData("Perception", pPerception);
+			const HousesInFOV& houses{ pPerception->Houses };
+
+			// Stay away from zones and house walls on our way to the safe point
+			AddZoneDangers(pBlackboard, pContextSteering, agentInfo.Position);
+			std::ranges::for_each(houses, [pContextSteering, &agentInfo](const HouseInfo& house) -> void { pContextSteering->AddDangerRectangle(agentInfo.Position, house.Center, house.Size, 0.5f); });
+
 			// Calculate the steering
-			SteeringPlugin_Output steeringOutput{ pSeek->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ *safePoint, Elite::Vector2{} }) };
+			const Elite::Vector2 target{ GetSafePointTarget(pBlackboard, agentInfo.Position, *safePoint) };
+			SteeringPlugin_Output steeringOutput{ pContextSteering->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ target, Elite::Vector2{} }) };
 
 			// Adapt the steering variable in our blackboard
 			pSteering->AngularVelocity = steeringOutput.AngularVelocity;
@@ -225,41 +409,61 @@ namespace DecisionMaking
 			pBlackboard->GetData("SteeringOutput", pSteering);
 			pSteering->RunMode = false;
 
-			std::vector<HouseInfo> houses{};
-			pBlackboard->GetData("Houses", houses);
+			PerceptionFrame* pPerception{};
+			pBlackboard->GetData("Perception", pPerception);
+			const HousesInFOV& houses{ pPerception->Houses };
 
-			HouseInfo* currentHouse{};
-			pBlackboard->GetData("CurrentHouse", currentHouse);
+			int currentHouse{ Memory::HouseRegistry::InvalidId };
 
-			std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-			pBlackboard->GetData("FoundHouses", foundHouses);
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
 
 			AgentInfo agentInfo{};
 			pBlackboard->GetData("AgentInfo", agentInfo);
 
+			MovementBehavior::Separation* pSeparation{};
+			pBlackboard->GetData("Separation", pSeparation);
+
 			// Store the new houses and store / update the entrances, also update our current house
-			std::ranges::for_each(houses, [foundHouses, &agentInfo, &currentHouse](const HouseInfo& house) -> void
+			std::ranges::for_each(houses, [pHouseRegistry, &agentInfo, &currentHouse, pSeparation](const HouseInfo& house) -> void
 				{
-					if (foundHouses->contains(house))
+					const int id{ pHouseRegistry->Find(house) };
+					if (id != Memory::HouseRegistry::InvalidId)
 					{
 						// A already found house but yet to be explored
-						if (!std::get<0>(foundHouses->at(house))) 
+						if (!pHouseRegistry->IsExplored(id)) 
 						{
-							std::get<1>(foundHouses->at(house)) = agentInfo.Position;
-							delete currentHouse;
-							currentHouse = new HouseInfo{ house };
+							pHouseRegistry->SetEntrance(id, agentInfo.Position);
+							currentHouse = id;
 						}
 					}
 					// Found a new house
 					else 
 					{
-						foundHouses->emplace(std::make_pair(house, std::make_tuple(false, agentInfo.Position, std::unordered_set<ItemInfo>{})));
-						delete currentHouse;
-						currentHouse = new HouseInfo{ house };
+						currentHouse = pHouseRegistry->Add(house, agentInfo.Position);
+						pSeparation->AddHouseWalls(house.Center, house.Size);
 					}
 				});
 
+			// Visit the unexplored houses in the order of the tour, the ones we just found go in it first
+			Navigation::TourOptimizer* pTourOptimizer{};
+			pBlackboard->GetData("TourOptimizer", pTourOptimizer);
+			pTourOptimizer->SetStart(agentInfo.Position);
+			for (int id{}; id < pHouseRegistry->GetCount(); ++id)
+			{
+				if (!pHouseRegistry->IsExplored(id)) pTourOptimizer->AddStop(id, pHouseRegistry->GetCenter(id));
+			}
+			if (pTourOptimizer->GetNextStop() != Navigation::TourOptimizer::InvalidId) currentHouse = pTourOptimizer->GetNextStop();
+
+			// We don't see an unexplored house, go to the closest one we know
+			if (currentHouse == Memory::HouseRegistry::InvalidId) currentHouse = pHouseRegistry->FindNearestUnexplored(agentInfo.Position);
+
 			pBlackboard->ChangeData("CurrentHouse", currentHouse);
+
+			// Plan a route to the house that stays clear of zombies, it gets repaired while we walk it
+			Navigation::DStarLite* pPlanner{};
+			pBlackboard->GetData("HousePathPlanner", pPlanner);
+			pPlanner->Initialize(agentInfo.Position, pHouseRegistry->GetCenter(currentHouse));
 		}
 
 		void GetInsideUnexploredHouse::Update(Blackboard* pBlackboard, float deltaTime) const
@@ -268,32 +472,67 @@ namespace DecisionMaking
 			pBlackboard->GetData("SteeringOutput", pSteering);
 
 			MovementBehavior::ISteeringBehavior* pSeek;
-			pBlackboard->GetData("Seek", pSeek);
+			pBlackboard->GetData("ArriveWithSeparation", pSeek);
+
+			// Other states share the arrive, so set where it stops every tick
+			MovementBehavior::Arrive* pArrive{};
+			pBlackboard->GetData("Arrive", pArrive);
+			pArrive->SetTargetRadius(1.0f);
 
 			AgentInfo agentInfo{};
 			pBlackboard->GetData("AgentInfo", agentInfo);
 
-			HouseInfo* currentHouse{};
+			int currentHouse{};
 			pBlackboard->GetData("CurrentHouse", currentHouse);
 
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
+
+			Navigation::DStarLite* pPlanner{};
+			pBlackboard->GetData("HousePathPlanner", pPlanner);
+
+			Navigation::NavigationGrid* pGrid{};
+			pBlackboard->GetData("NavigationGrid", pGrid);
+
+			std::vector<Elite::Vector2>* pPath{};
+			pBlackboard->GetData("HousePath", pPath);
+
+			// Repair the path with the cells that changed this frame and aim a couple of cells ahead on it
+			pPlanner->UpdateStart(agentInfo.Position);
+			pPlanner->Repair(pGrid->GetChangedCells());
+			pPlanner->ComputeShortestPath(m_MaximumExpansions);
+
+			// The last place we were outside the house is where we came in
+			if (!pHouseRegistry->Contains(currentHouse, agentInfo.Position)) pHouseRegistry->SetEntrance(currentHouse, agentInfo.Position);
+
+			Elite::Vector2 target{ pHouseRegistry->GetCenter(currentHouse) };
+			if (pPlanner->GetPath(*pPath) && !pPath->empty())
+			{
+				// Wait at the edge of a zone that is in the way instead of walking into it, unless we are already in one
+				Memory::ZoneRegistry* pZoneRegistry{};
+				pBlackboard->GetData("ZoneRegistry", pZoneRegistry);
+				const int blockedSegment{ pZoneRegistry->FindFirstBlockedSegment(*pPath, 1.0f) };
+				if ((blockedSegment != -1) && !pZoneRegistry->ContainsPoint(agentInfo.Position, 1.0f)) pPath->resize(size_t(blockedSegment) + 1);
+
+				target = pPath->at(std::min(size_t(2), pPath->size() - 1));
+			}
+
 			// Calculate the steering
-			SteeringPlugin_Output steeringOutput{ pSeek->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ currentHouse->Center, Elite::Vector2{} }) };
+			SteeringPlugin_Output steeringOutput{ pSeek->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ target, Elite::Vector2{} }) };
 
 			// Adapt the steering variable in our blackboard
 			pSteering->AngularVelocity = steeringOutput.AngularVelocity;
 			pSteering->LinearVelocity = steeringOutput.LinearVelocity;
 			pSteering->AutoOrient = steeringOutput.AutoOrient;
 
-			std::vector<ItemInfo> items{};
-			pBlackboard->GetData("Items", items);
+			PerceptionFrame* pPerception{};
+			pBlackboard->GetData("Perception", pPerception);
+			const ItemsInFOV& items{ pPerception->Items };
 
 			// Store new items that we see
 			if (items.size() > 0)
 			{
-				std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-				pBlackboard->GetData("FoundHouses", foundHouses);
-
-				std::ranges::for_each(items, [foundHouses, currentHouse](const ItemInfo& item) -> void { std::get<2>(foundHouses->at(*currentHouse)).emplace(item); });
+				std::ranges::for_each(items, [pHouseRegistry, currentHouse](const ItemInfo& item) -> void { pHouseRegistry->AddItem(currentHouse, item); });
 			}
 		}
 
@@ -313,33 +552,35 @@ namespace DecisionMaking
 
 			pSteering->RunMode = false;
 
-			HouseInfo* currentHouse{};
+			int currentHouse{};
 			pBlackboard->GetData("CurrentHouse", currentHouse);
 
-			std::array<std::pair<bool, Elite::Vector2>, 4>* path;
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
+
+			std::pair<int, std::vector<std::pair<bool, Elite::Vector2>>>* path{};
 			pBlackboard->GetData("InHousePath", path);
 
-			// Create a path that takes us around the inside of the house
+			// Coming back from grabbing an item, carry on with the sweep we already started
+			if (path->first == currentHouse) return;
+
+			AgentInfo agentInfo{};
+			pBlackboard->GetData("AgentInfo", agentInfo);
 
-			// Left bottom
-			path->at(0).second.x = currentHouse->Center.x - (currentHouse->Size.x / 2.0f) + 4.5f;
-			path->at(0).second.y = currentHouse->Center.y - (currentHouse->Size.y / 2.0f) + 4.5f;
-			path->at(0).first = false;
+			Navigation::SweepPlanner* pSweepPlanner{};
+			pBlackboard->GetData("SweepPlanner", pSweepPlanner);
 
-			// left Top
-			path->at(3).second.x = currentHouse->Center.x - (currentHouse->Size.x / 2.0f) + 4.5f;
-			path->at(3).second.y = currentHouse->Center.y + (currentHouse->Size.y / 2.0f) - 4.5f;
-			path->at(3).first = false;
+			// Walk past as few points as possible so our field of view covers the whole inside, starting from where we came in
+			std::vector<Elite::Vector2> viewpoints{};
+			pSweepPlanner->Plan(pHouseRegistry->GetCenter(currentHouse), pHouseRegistry->GetSize(currentHouse), agentInfo, viewpoints);
 
-			// Right Top
-			path->at(2).second.x = currentHouse->Center.x + (currentHouse->Size.x / 2.0f) - 4.5f;
-			path->at(2).second.y = currentHouse->Center.y + (currentHouse->Size.y / 2.0f) - 4.5f;
-			path->at(2).first = false;
+			path->first = currentHouse;
+			path->second.clear();
+			std::ranges::transform(viewpoints, std::back_inserter(path->second), [](const Elite::Vector2& viewpoint) -> std::pair<bool, Elite::Vector2> { return std::pair<bool, Elite::Vector2>{ false, viewpoint }; });
 
-			// Right bottom
-			path->at(1).second.x = currentHouse->Center.x + (currentHouse->Size.x / 2.0f) - 4.5f;
-			path->at(1).second.y = currentHouse->Center.y - (currentHouse->Size.y / 2.0f) + 4.5f;
-			path->at(1).first = false;
+			StatisticsInfo stats{};
+			pBlackboard->GetData("StatisticsInfo", stats);
+			pBlackboard->ChangeData("HouseEnterTime", stats.TimeSurvived);
 		}
 
 		void ExploreHouse::Update(Blackboard* pBlackboard, float deltaTime) const
@@ -353,12 +594,12 @@ namespace DecisionMaking
 			AgentInfo agentInfo{};
 			pBlackboard->GetData("AgentInfo", agentInfo);
 
-			std::array<std::pair<bool, Elite::Vector2>, 4>* path;
+			std::pair<int, std::vector<std::pair<bool, Elite::Vector2>>>* path{};
 			pBlackboard->GetData("InHousePath", path);
 
 			// Go to the next point of our path
-			auto itNextPoint{ std::ranges::find_if(*path, [](const std::pair<bool, Elite::Vector2>& point) -> bool { return !point.first; }) };
-			if (itNextPoint != std::end(*path))
+			auto itNextPoint{ std::ranges::find_if(path->second, [](const std::pair<bool, Elite::Vector2>& point) -> bool { return !point.first; }) };
+			if (itNextPoint != std::end(path->second))
 			{
 				// Calculate the steering
 				SteeringPlugin_Output steeringOutput{ seek->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ itNextPoint->second, Elite::Vector2{} }) };
@@ -382,6 +623,14 @@ namespace DecisionMaking
 #pragma endregion
 
 #pragma region GetItem
+		void GetItem::RecordGrabTime(std::pair<float, int>* pGrabStatistics, float grabTime)
+		{
+			pGrabStatistics->first += grabTime;
+			++pGrabStatistics->second;
+
+			std::cout << "Average time to grab: " << (pGrabStatistics->first / float(pGrabStatistics->second)) << "s over " << pGrabStatistics->second << " items" << std::endl;
+		}
+
 		void GetItem::OnEnter(Blackboard* pBlackboard) const
 		{
 			std::cout << "State Get Item" << std::endl;
@@ -391,19 +640,35 @@ namespace DecisionMaking
 
 			pSteering->RunMode = false;
 
-			std::vector<ItemInfo> items{};
-			pBlackboard->GetData("Items", items);
+			pBlackboard->ChangeData("GrabTimer", 0.0f);
+			std::pair<float, float>* pGrabProgress{};
+			pBlackboard->GetData("GrabProgress", pGrabProgress);
+			*pGrabProgress = std::pair<float, float>{ FLT_MAX, 0.0f };
+			pBlackboard->ChangeData("TargetItemHandled", false);
+
+			PerceptionFrame* pPerception{};
+			pBlackboard->GetData("Perception", pPerception);
+			const ItemsInFOV& items{ pPerception->Items };
 
-			pBlackboard->ChangeData("TargetItem", new ItemInfo{ items.at(0) });
+			Memory::Inventory* pInventory{};
+			pBlackboard->GetData("Inventory", pInventory);
 
-			HouseInfo* currentHouse{};
+			InventoryOptimizer* pInventoryOptimizer{};
+			pBlackboard->GetData("InventoryOptimizer", pInventoryOptimizer);
+
+			// With room go for the closest item we see (they are sorted from close to far), with a full inventory for the best swap
+			InventoryOptimizer::Action action{};
+			if (!pInventory->HasEmptySlot() && pInventoryOptimizer->FindBestAction(*pInventory, items, pPerception->Stats.Difficulty, action)) pBlackboard->ChangeData("TargetItem", new ItemInfo{ items[size_t(action.candidate)] });
+			else pBlackboard->ChangeData("TargetItem", new ItemInfo{ *pPerception->GetClosestItem() });
+
+			int currentHouse{};
 			pBlackboard->GetData("CurrentHouse", currentHouse);
 
-			std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-			pBlackboard->GetData("FoundHouses", foundHouses);
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
 
 			// Store new items
-			std::ranges::for_each(items, [foundHouses, currentHouse](const ItemInfo& item) -> void { std::get<2>(foundHouses->at(*currentHouse)).emplace(item); });
+			std::ranges::for_each(items, [pHouseRegistry, currentHouse](const ItemInfo& item) -> void { pHouseRegistry->AddItem(currentHouse, item); });
 		}
 
 		void GetItem::Update(Blackboard* pBlackboard, float deltaTime) const
@@ -418,7 +683,12 @@ namespace DecisionMaking
 			pBlackboard->GetData("SteeringOutput", steering);
 
 			MovementBehavior::ISteeringBehavior* pSeek{};
-			pBlackboard->GetData("Seek", pSeek);
+			pBlackboard->GetData("ArriveWithSeparation", pSeek);
+
+			// Stop well within grab range instead of running over the item, other states share the arrive so this is set every tick
+			MovementBehavior::Arrive* pArrive{};
+			pBlackboard->GetData("Arrive", pArrive);
+			pArrive->SetTargetRadius(agentInfo.GrabRange * 0.5f);
 
 			SteeringPlugin_Output output{ pSeek->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ targetItem->Location, Elite::Vector2{} }) };
 
@@ -426,52 +696,118 @@ namespace DecisionMaking
 			steering->AngularVelocity = output.AngularVelocity;
 			steering->AutoOrient = output.AutoOrient;
 
+			float grabTimer{};
+			pBlackboard->GetData("GrabTimer", grabTimer);
+			grabTimer += deltaTime;
+			pBlackboard->ChangeData("GrabTimer", grabTimer);
+
+			// Give up on items we stop getting closer to (behind a wall, stuck on a corner), and leave them out of what we see from now on
+			std::pair<float, float>* pGrabProgress{};
+			pBlackboard->GetData("GrabProgress", pGrabProgress);
+
+			float grabStuckTime{};
+			pBlackboard->GetData("GrabStuckTime", grabStuckTime);
+
+			const float distance{ agentInfo.Position.Distance(targetItem->Location) };
+			if (distance < (pGrabProgress->first - 0.5f)) *pGrabProgress = std::pair<float, float>{ distance, 0.0f };
+			else pGrabProgress->second += deltaTime;
+
+			if (pGrabProgress->second > grabStuckTime)
+			{
+				std::vector<int>* pUnreachableItems{};
+				pBlackboard->GetData("UnreachableItems", pUnreachableItems);
+				pUnreachableItems->push_back(targetItem->ItemHash);
+
+				Memory::ItemMemory* pItemMemory{};
+				pBlackboard->GetData("ItemMemory", pItemMemory);
+				pItemMemory->Remove(targetItem->ItemHash);
+
+				// Needed for condition GotTargetItem
+				pBlackboard->ChangeData("TargetItemHandled", true);
+				return;
+			}
+
 			// Pickup non garbage items if we are close enough, if it is garbage destroy it
 			if (agentInfo.Position.Distance(targetItem->Location) <= agentInfo.GrabRange)
 			{
 				IExamInterface* pInterface{};
 				pBlackboard->GetData("Interface", pInterface);
 
-				std::vector<ItemInfo>* inventory{};
-				pBlackboard->GetData("Inventory", inventory);
+				std::pair<float, int>* grabStatistics{};
+				pBlackboard->GetData("GrabStatistics", grabStatistics);
 
-				auto itEmptySlot{ std::ranges::find_if(*inventory, [](const ItemInfo& item) -> bool { return item.Type == eItemType::GARBAGE; }) };
-				UINT inventorySlot{ UINT(std::distance(std::begin(*inventory), itEmptySlot)) };
+				Memory::Inventory* pInventory{};
+				pBlackboard->GetData("Inventory", pInventory);
+
+				int inventorySlot{ pInventory->GetFirstEmptySlot() };
+
+				Memory::ItemMemory* pItemMemory{};
+				pBlackboard->GetData("ItemMemory", pItemMemory);
 
 				switch (targetItem->Type)
 				{
 				case eItemType::GARBAGE:
 				{
 					pInterface->DestroyItem(*targetItem);
+					pItemMemory->Remove(targetItem->ItemHash);
 
-					// Update inventory slot needed for condition GotTargetItem
-					inventory->at(inventorySlot) = ItemInfo{ *targetItem };
+					// Needed for condition GotTargetItem
+					pBlackboard->ChangeData("TargetItemHandled", true);
+					RecordGrabTime(grabStatistics, grabTimer);
 					break;
 				}
 				default:
-					if (pInterface->GrabItem(*targetItem))
+				{
+					// With a full inventory check the swap is still worth it, we might have used something on the way
+					InventoryOptimizer::Action action{};
+					if (inventorySlot == Memory::Inventory::InvalidSlot)
 					{
-						// Add item
-						pInterface->Inventory_AddItem(inventorySlot, *targetItem);
-						inventory->at(inventorySlot) = ItemInfo{ *targetItem };
+						InventoryOptimizer* pInventoryOptimizer{};
+						pBlackboard->GetData("InventoryOptimizer", pInventoryOptimizer);
+
+						StatisticsInfo stats{};
+						pBlackboard->GetData("StatisticsInfo", stats);
+
+						if (pInventoryOptimizer->FindBestAction(*pInventory, std::span<const ItemInfo>{ targetItem, 1 }, stats.Difficulty, action)) inventorySlot = action.dropSlot;
+					}
+
+					// Leave the item where it is when it isn't worth a slot
+					if (inventorySlot == Memory::Inventory::InvalidSlot)
+					{
+						pBlackboard->ChangeData("TargetItemHandled", true);
+					}
+					// Only give up the slot we swap out once we hold the new item, so a failed grab never costs us what we carry
+					else if (pInterface->GrabItem(*targetItem))
+					{
+						const bool slotFree{ (action.dropSlot == Memory::Inventory::InvalidSlot) || pInventory->Remove(UINT(action.dropSlot)) };
+
+						// Try again next tick when it didn't end up in the inventory, the stuck timer gives up on it if it never does
+						if (slotFree && pInventory->Add(UINT(inventorySlot), *targetItem))
+						{
+							pItemMemory->Remove(targetItem->ItemHash);
+							pBlackboard->ChangeData("TargetItemHandled", true);
+							RecordGrabTime(grabStatistics, grabTimer);
+						}
 					}
 					break;
 				}
+				}
 			}
 
 			// Store new items we see
-			std::vector<ItemInfo> items{};
-			pBlackboard->GetData("Items", items);
+			PerceptionFrame* pPerception{};
+			pBlackboard->GetData("Perception", pPerception);
+			const ItemsInFOV& items{ pPerception->Items };
 
 			if (items.size() > 0)
 			{
-				HouseInfo* currentHouse{};
+				int currentHouse{};
 				pBlackboard->GetData("CurrentHouse", currentHouse);
 
-				std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-				pBlackboard->GetData("FoundHouses", foundHouses);
+				Memory::HouseRegistry* pHouseRegistry{};
+				pBlackboard->GetData("HouseRegistry", pHouseRegistry);
 
-				std::ranges::for_each(items, [foundHouses, currentHouse](const ItemInfo& item) -> void { std::get<2>(foundHouses->at(*currentHouse)).emplace(item); });
+				std::ranges::for_each(items, [pHouseRegistry, currentHouse](const ItemInfo& item) -> void { pHouseRegistry->AddItem(currentHouse, item); });
 			}
 		}
 
@@ -480,14 +816,11 @@ namespace DecisionMaking
 			ItemInfo* targetItem{};
 			pBlackboard->GetData("TargetItem", targetItem);
 
-			HouseInfo* currentHouse{};
-			pBlackboard->GetData("CurrentHouse", currentHouse);
-
-			std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-			pBlackboard->GetData("FoundHouses", foundHouses);
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
 
-			// Remove the item from our found houses information, at the current house
-			std::get<2>(foundHouses->at(*currentHouse)).erase(*targetItem);
+			// Remove the item from our found houses information, from whichever house we saw it in
+			pHouseRegistry->RemoveItem(*targetItem);
 
 			delete targetItem;
 			targetItem = nullptr;
@@ -516,19 +849,24 @@ namespace DecisionMaking
 			pBlackboard->GetData("SteeringOutput", pSteering);
 
 			MovementBehavior::ISteeringBehavior* pSeek{};
-			pBlackboard->GetData("Seek", pSeek);
+			pBlackboard->GetData("ArriveWithSeparation", pSeek);
+
+			// Come to a stop at the entrance instead of running past it, other states share the arrive so this is set every tick
+			MovementBehavior::Arrive* pArrive{};
+			pBlackboard->GetData("Arrive", pArrive);
+			pArrive->SetTargetRadius(1.0f);
 
-			HouseInfo* currentHouse{};
+			int currentHouse{};
 			pBlackboard->GetData("CurrentHouse", currentHouse);
 
-			std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-			pBlackboard->GetData("FoundHouses", foundHouses);
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
 
 			// Calculate the steering
 			SteeringPlugin_Output steeringOutput{ pSeek->CalculateSteering(deltaTime, agentInfo, 
 				MovementBehavior::TargetData
 				{ 
-					std::get<1>(foundHouses->at(*currentHouse)),
+					pHouseRegistry->GetEntrance(currentHouse),
 					Elite::Vector2{}
 				}
 			) };
@@ -541,21 +879,43 @@ namespace DecisionMaking
 
 		void LeaveHouse::OnExit(Blackboard* pBlackboard) const
 		{
-			HouseInfo* currentHouse{};
+			int currentHouse{};
 			pBlackboard->GetData("CurrentHouse", currentHouse);
 
-			std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-			pBlackboard->GetData("FoundHouses", foundHouses);
+			Memory::HouseRegistry* pHouseRegistry{};
+			pBlackboard->GetData("HouseRegistry", pHouseRegistry);
 
-			std::array<std::pair<bool, Elite::Vector2>, 4>* path{};
+			std::pair<int, std::vector<std::pair<bool, Elite::Vector2>>>* path{};
 			pBlackboard->GetData("InHousePath", path);
 
-			bool pathCompleted{ std::ranges::all_of(*path, [](const std::pair<bool, Elite::Vector2>& point) -> bool { return point.first; }) };
+			bool pathCompleted{ std::ranges::all_of(path->second, [](const std::pair<bool, Elite::Vector2>& point) -> bool { return point.first; }) };
 
 			// If we left the house without any items left behind, and we did a full tour inside the house mark it as explored
-			if ((std::get<2>(foundHouses->at(*currentHouse)).size() == 0) && pathCompleted)
+			if (pHouseRegistry->GetItems(currentHouse).empty() && pathCompleted)
 			{
-				std::get<0>(foundHouses->at(*currentHouse)) = true;
+				pHouseRegistry->SetExplored(currentHouse, true);
+
+				std::pair<float, int>* travelStatistics{};
+				pBlackboard->GetData("TravelStatistics", travelStatistics);
+				++travelStatistics->second;
+
+				std::cout << "Distance travelled: " << travelStatistics->first << " over " << travelStatistics->second << " houses, " << (travelStatistics->first / float(travelStatistics->second)) << " per house" << std::endl;
+
+				// Time from starting the sweep until we are done with the house
+				StatisticsInfo stats{};
+				pBlackboard->GetData("StatisticsInfo", stats);
+
+				float houseEnterTime{};
+				pBlackboard->GetData("HouseEnterTime", houseEnterTime);
+
+				std::pair<float, int>* exploreStatistics{};
+				pBlackboard->GetData("ExploreStatistics", exploreStatistics);
+				exploreStatistics->first += stats.TimeSurvived - houseEnterTime;
+				++exploreStatistics->second;
+
+				std::cout << "Time exploring: " << exploreStatistics->first << " seconds over " << exploreStatistics->second << " houses, " << (exploreStatistics->first / float(exploreStatistics->second)) << " seconds per house" << std::endl;
+
+				path->first = Memory::HouseRegistry::InvalidId;
 			}
 		}
 #pragma endregion
@@ -573,19 +933,30 @@ namespace DecisionMaking
 			Elite::Vector2* safePoint{};
 			pBlackboard->GetData("SafePoint", safePoint);
 
-			std::vector<PurgeZoneInfo> zones{};
-			pBlackboard->GetData("PurgeZones", zones);
+			AgentInfo agentInfo{};
+			pBlackboard->GetData("AgentInfo", agentInfo);
 
-			// Set our safe point to a set distance outside the zone as close as possible to the center of the world
-			if (zones.at(0).Center.x > 0.0f) safePoint->x = zones.at(0).Center.x - (zones.at(0).Radius + 5.0f);
-			else safePoint->x = zones.at(0).Center.x + (zones.at(0).Radius + 5.0f);
-			if (zones.at(0).Center.y > 0.0f) safePoint->y = zones.at(0).Center.y - (zones.at(0).Radius + 5.0f);
-			else safePoint->y = zones.at(0).Center.y + (zones.at(0).Radius + 5.0f);
+			Memory::ZoneRegistry* pZoneRegistry{};
+			pBlackboard->GetData("ZoneRegistry", pZoneRegistry);
+
+			// Run from the zone we are in or else the closest one, preferably straight out of it
+			int zone{ pZoneRegistry->FindContainingZone(agentInfo.Position, 5.0f) };
+			if (zone == -1) zone = pZoneRegistry->FindNearestZone(agentInfo.Position);
+			*safePoint = agentInfo.Position;
+			if (zone != -1)
+			{
+				// Of all the points a set distance outside the zone prefer the ones without zombies or other zones around
+				const Elite::Vector2 center{ pZoneRegistry->GetCenter(zone) };
+				const float radius{ pZoneRegistry->GetRadius(zone) + 5.0f };
+				*safePoint = FindSafePoint(pBlackboard, center, radius, center + ((agentInfo.Position - center).GetNormalized() * radius));
+			}
 
 			IExamInterface* pInterface{};
 			pBlackboard->GetData("Interface", pInterface);
 
 			*safePoint = pInterface->NavMesh_GetClosestPathPoint(*safePoint);
+
+			RequestSafePointPath(pBlackboard, agentInfo.Position, *safePoint);
 		}
 
 		void RunAwayFromZone::Update(Blackboard* pBlackboard, float deltaTime) const
@@ -599,10 +970,25 @@ namespace DecisionMaking
 			SteeringPlugin_Output* steering{};
 			pBlackboard->GetData("SteeringOutput", steering);
 
-			MovementBehavior::ISteeringBehavior* pSeek{};
-			pBlackboard->GetData("Seek", pSeek);
+			MovementBehavior::ContextSteering* pContextSteering{};
+			pBlackboard->GetData("ContextSteering", pContextSteering);
+
+			PerceptionFrame* pPerception{};
+			pBlackboard->GetData("Perception", pPerception);
+			const EnemiesInFOV& enemies{ pPerception->Enemies };
+
+			// Every zone we know and enemy we see is dangerous, not only the zone that made us run
+			AddZoneDangers(pBlackboard, pContextSteering, agentInfo.Position);
+			std::ranges::for_each(enemies, [pContextSteering, &agentInfo](const EnemyInfo& enemy) -> void { pContextSteering->AddDanger(agentInfo.Position, enemy.Location, enemy.Size, 0.5f); });
+
+			// The flow field knows the way out of the zone, it helps the context map when the safe point is behind the zone
+			Navigation::FlowField* pFlowField{};
+			pBlackboard->GetData("SafetyFlowField", pFlowField);
+			const Elite::Vector2& flowDirection{ pFlowField->GetDirection(agentInfo.Position) };
+			if (flowDirection != Elite::Vector2{}) pContextSteering->AddInterest(agentInfo.Position, agentInfo.Position + (flowDirection * 10.0f), 0.5f);
 
-			SteeringPlugin_Output output{ pSeek->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ *safePoint, Elite::Vector2{} }) };
+			const Elite::Vector2 target{ GetSafePointTarget(pBlackboard, agentInfo.Position, *safePoint) };
+			SteeringPlugin_Output output{ pContextSteering->CalculateSteering(deltaTime, agentInfo, MovementBehavior::TargetData{ target, Elite::Vector2{} }) };
 
 			steering->LinearVelocity = output.LinearVelocity;
 			steering->AngularVelocity = output.AngularVelocity;
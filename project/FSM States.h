@@ -101,6 +101,9 @@ namespace DecisionMaking
 			virtual void OnEnter(Blackboard* pBlackboard) const override;
 			virtual void Update(Blackboard* pBlackboard, float deltaTime) const override;
 			virtual void OnExit(Blackboard* pBlackboard) const override;
+		private:
+			// Upper bound on the work the path repair can do in one frame
+			const int m_MaximumExpansions{ 2000 };
 		};
 
 		class ExploreHouse final : public IState
@@ -133,6 +136,9 @@ namespace DecisionMaking
 			virtual void OnEnter(Blackboard* pBlackboard) const override;
 			virtual void Update(Blackboard* pBlackboard, float deltaTime) const override;
 			virtual void OnExit(Blackboard* pBlackboard) const override;
+
+		private:
+			static void RecordGrabTime(std::pair<float, int>* pGrabStatistics, float grabTime);
 		};
 
 		class LeaveHouse final : public IState
@@ -0,0 +1,187 @@
+#ifndef FLAT_HASH_MAP
+#define FLAT_HASH_MAP
+
+#include <vector>
+#include <functional>
+
+namespace Containers
+{
+	// Open addressing hash map with linear probing, keys and values live in flat arrays so small maps stay in a few cache lines
+	template<typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+	class FlatHashMap final
+	{
+	public:
+		explicit FlatHashMap(size_t capacity = 16) :
+			m_Used{},
+			m_Keys{},
+			m_Values{},
+			m_Size{ 0 },
+			m_Mask{ 0 }
+		{
+			Rehash(capacity);
+		}
+		~FlatHashMap() = default;
+
+		FlatHashMap(const FlatHashMap&) = default;
+		FlatHashMap& operator=(const FlatHashMap&) = default;
+		FlatHashMap(FlatHashMap&&) = default;
+		FlatHashMap& operator=(FlatHashMap&&) = default;
+
+		Value* Find(const Key& key)
+		{
+			const size_t slot{ FindSlot(key) };
+			return m_Used[slot] ? &m_Values[slot] : nullptr;
+		}
+
+		const Value* Find(const Key& key) const
+		{
+			const size_t slot{ FindSlot(key) };
+			return m_Used[slot] ? &m_Values[slot] : nullptr;
+		}
+
+		bool Contains(const Key& key) const
+		{
+			return m_Used[FindSlot(key)];
+		}
+
+		// Returns false and keeps the old value if the key is already in the map
+		bool Insert(const Key& key, const Value& value)
+		{
+			// Keep at least half of the slots free so probe sequences stay short
+			if ((m_Size + 1) * 2 > m_Used.size()) Rehash(m_Used.size() * 2);
+
+			const size_t slot{ FindSlot(key) };
+			if (m_Used[slot]) return false;
+
+			m_Used[slot] = true;
+			m_Keys[slot] = key;
+			m_Values[slot] = value;
+			++m_Size;
+			return true;
+		}
+
+		bool Erase(const Key& key)
+		{
+			size_t slot{ FindSlot(key) };
+			if (!m_Used[slot]) return false;
+
+			// Shift the following entries of the probe sequence back instead of leaving a tombstone
+			size_t next{ (slot + 1) & m_Mask };
+			while (m_Used[next])
+			{
+				const size_t home{ Hash{}(m_Keys[next]) & m_Mask };
+				if (((next - home) & m_Mask) >= ((next - slot) & m_Mask))
+				{
+					m_Keys[slot] = m_Keys[next];
+					m_Values[slot] = m_Values[next];
+					slot = next;
+				}
+				next = (next + 1) & m_Mask;
+			}
+
+			m_Used[slot] = false;
+			--m_Size;
+			return true;
+		}
+
+		size_t Size() const
+		{
+			return m_Size;
+		}
+
+		bool Empty() const
+		{
+			return m_Size == 0;
+		}
+
+		void Clear()
+		{
+			std::fill(std::begin(m_Used), std::end(m_Used), false);
+			m_Size = 0;
+		}
+
+		// Calls function(const Key&, Value&) for every entry, in no particular order
+		template<typename Function>
+		void ForEach(Function function)
+		{
+			for (size_t slot{}; slot < m_Used.size(); ++slot)
+			{
+				if (m_Used[slot]) function(m_Keys[slot], m_Values[slot]);
+			}
+		}
+
+	private:
+		std::vector<bool> m_Used;
+		std::vector<Key> m_Keys;
+		std::vector<Value> m_Values;
+		size_t m_Size;
+		size_t m_Mask;
+
+		// The slot that holds the key, or the empty slot where it would go
+		size_t FindSlot(const Key& key) const
+		{
+			size_t slot{ Hash{}(key) & m_Mask };
+			while (m_Used[slot] && !Equal{}(m_Keys[slot], key)) slot = (slot + 1) & m_Mask;
+
+			return slot;
+		}
+
+		void Rehash(size_t capacity)
+		{
+			size_t slotCount{ 8 };
+			while (slotCount < capacity) slotCount *= 2;
+
+			std::vector<bool> used(slotCount, false);
+			std::vector<Key> keys(slotCount);
+			std::vector<Value> values(slotCount);
+			std::swap(used, m_Used);
+			std::swap(keys, m_Keys);
+			std::swap(values, m_Values);
+			m_Mask = slotCount - 1;
+			m_Size = 0;
+
+			for (size_t slot{}; slot < used.size(); ++slot)
+			{
+				if (used[slot]) Insert(keys[slot], values[slot]);
+			}
+		}
+	};
+
+	// Set on top of the flat hash map
+	template<typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+	class FlatHashSet final
+	{
+	public:
+		explicit FlatHashSet(size_t capacity = 16) :
+			m_Map{ capacity }
+		{
+
+		}
+		~FlatHashSet() = default;
+
+		FlatHashSet(const FlatHashSet&) = default;
+		FlatHashSet& operator=(const FlatHashSet&) = default;
+		FlatHashSet(FlatHashSet&&) = default;
+		FlatHashSet& operator=(FlatHashSet&&) = default;
+
+		bool Contains(const Key& key) const { return m_Map.Contains(key); }
+		bool Insert(const Key& key) { return m_Map.Insert(key, 1); }
+		bool Erase(const Key& key) { return m_Map.Erase(key); }
+		size_t Size() const { return m_Map.Size(); }
+		bool Empty() const { return m_Map.Empty(); }
+		void Clear() { m_Map.Clear(); }
+
+		// Calls function(const Key&) for every key, in no particular order
+		template<typename Function>
+		void ForEach(Function function)
+		{
+			m_Map.ForEach([&function](const Key& key, unsigned char) -> void { function(key); });
+		}
+
+	private:
+		// Not bool, std::vector<bool> can't hand out references to its elements
+		FlatHashMap<Key, unsigned char, Hash, Equal> m_Map;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "stdafx.h"
+#include "Flow Field.h"
+#include "Navigation Grid.h"
+#include <chrono>
+
+namespace Navigation
+{
+	FlowField::FlowField(const NavigationGrid* pGrid, float safeDistance, float dangerThreshold) :
+		m_pGrid{ pGrid },
+		m_SafeCells{ std::max(int(ceilf(safeDistance / pGrid->GetCellSize())), 1) },
+		m_DangerThreshold{ dangerThreshold },
+		m_PurgeZones{},
+		m_ZoneCounts(size_t(pGrid->GetCellCount()), 0),
+		m_Dangerous(size_t(pGrid->GetCellCount()), false),
+		m_Safeties(size_t(pGrid->GetCellCount()), float(m_SafeCells)),
+		m_Directions(size_t(pGrid->GetCellCount()), Elite::Vector2{}),
+		m_DirtySources{},
+		m_DirtyCells{},
+		m_InDirtyCells(size_t(pGrid->GetCellCount()), false),
+		m_NextDirtyCell{ 0 }
+	{
+
+	}
+
+	void FlowField::AddPurgeZone(const Elite::Vector2& center, float radius, float lifeTime)
+	{
+		auto itZone{ std::ranges::find_if(m_PurgeZones, [&center](const PurgeZone& zone) -> bool { return zone.center.DistanceSquared(center) < 0.25f; }) };
+		if (itZone != std::end(m_PurgeZones))
+		{
+			itZone->lifeTime = lifeTime;
+			return;
+		}
+
+		m_PurgeZones.push_back(PurgeZone{ center, radius, lifeTime });
+		MarkZone(m_PurgeZones.back(), 1);
+	}
+
+	void FlowField::Update(float deltaTime, long long budget)
+	{
+		// Forget zones we haven't seen for a while
+		for (size_t index{}; index < m_PurgeZones.size();)
+		{
+			m_PurgeZones[index].lifeTime -= deltaTime;
+			if (m_PurgeZones[index].lifeTime > 0.0f)
+			{
+				++index;
+				continue;
+			}
+
+			MarkZone(m_PurgeZones[index], -1);
+			m_PurgeZones[index] = m_PurgeZones.back();
+			m_PurgeZones.pop_back();
+		}
+
+		// Cells whose danger changed on the grid might have become (un)dangerous
+		const std::vector<int>& changedCells{ m_pGrid->GetChangedCells() };
+		m_DirtySources.insert(std::end(m_DirtySources), std::begin(changedCells), std::end(changedCells));
+		std::ranges::for_each(m_DirtySources, [this](int cell) -> void { RefreshSource(cell); });
+		m_DirtySources.clear();
+
+		// Work through the dirty cells, checking the clock every few cells
+		const auto start{ std::chrono::steady_clock::now() };
+		while (m_NextDirtyCell < m_DirtyCells.size())
+		{
+			const int cell{ m_DirtyCells[m_NextDirtyCell++] };
+			m_InDirtyCells[cell] = false;
+			RefreshSafety(cell);
+
+			if (((m_NextDirtyCell % 32) == 0) && (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() >= budget)) break;
+		}
+
+		if (m_NextDirtyCell == m_DirtyCells.size())
+		{
+			m_DirtyCells.clear();
+			m_NextDirtyCell = 0;
+		}
+	}
+
+	const Elite::Vector2& FlowField::GetDirection(const Elite::Vector2& position) const
+	{
+		return m_Directions[m_pGrid->GetCellIndex(position)];
+	}
+
+	float FlowField::GetSafety(const Elite::Vector2& position) const
+	{
+		return m_Safeties[m_pGrid->GetCellIndex(position)] * m_pGrid->GetCellSize();
+	}
+
+	bool FlowField::IsUpToDate() const
+	{
+		return m_DirtyCells.empty();
+	}
+
+	void FlowField::MarkZone(const PurgeZone& zone, int change)
+	{
+		const Elite::Vector2 extent{ zone.radius, zone.radius };
+		const int minimumCell{ m_pGrid->GetCellIndex(zone.center - extent) };
+		const int maximumCell{ m_pGrid->GetCellIndex(zone.center + extent) };
+
+		for (int row{ m_pGrid->GetRow(minimumCell) }; row <= m_pGrid->GetRow(maximumCell); ++row)
+		{
+			for (int column{ m_pGrid->GetColumn(minimumCell) }; column <= m_pGrid->GetColumn(maximumCell); ++column)
+			{
+				const int cell{ m_pGrid->GetCellIndex(column, row) };
+				if (m_pGrid->GetCellCenter(cell).DistanceSquared(zone.center) > (zone.radius * zone.radius)) continue;
+
+				m_ZoneCounts[cell] = static_cast<unsigned char>(m_ZoneCounts[cell] + change);
+				m_DirtySources.push_back(cell);
+			}
+		}
+	}
+
+	void FlowField::RefreshSource(int cell)
+	{
+		const bool dangerous{ (m_ZoneCounts[cell] > 0) || (m_pGrid->GetDanger(cell) >= m_DangerThreshold) };
+		if (dangerous == m_Dangerous[cell]) return;
+
+		m_Dangerous[cell] = dangerous;
+
+		// Only cells within the safe distance can have this cell as their closest danger
+		const int column{ m_pGrid->GetColumn(cell) };
+		const int row{ m_pGrid->GetRow(cell) };
+		for (int rowOffset{ -m_SafeCells }; rowOffset <= m_SafeCells; ++rowOffset)
+		{
+			for (int columnOffset{ -m_SafeCells }; columnOffset <= m_SafeCells; ++columnOffset)
+			{
+				const int dirtyCell{ m_pGrid->GetCellIndex(column + columnOffset, row + rowOffset) };
+				if ((dirtyCell == -1) || m_InDirtyCells[dirtyCell]) continue;
+
+				m_InDirtyCells[dirtyCell] = true;
+				m_DirtyCells.push_back(dirtyCell);
+			}
+		}
+	}
+
+	void FlowField::RefreshSafety(int cell)
+	{
+		// Distance to the closest cell of the other kind, so safe cells measure to danger and dangerous cells to safety
+		const bool dangerous{ m_Dangerous[cell] };
+		const int column{ m_pGrid->GetColumn(cell) };
+		const int row{ m_pGrid->GetRow(cell) };
+		int closestDistanceSquared{ m_SafeCells * m_SafeCells };
+
+		for (int rowOffset{ -m_SafeCells }; rowOffset <= m_SafeCells; ++rowOffset)
+		{
+			for (int columnOffset{ -m_SafeCells }; columnOffset <= m_SafeCells; ++columnOffset)
+			{
+				const int distanceSquared{ (rowOffset * rowOffset) + (columnOffset * columnOffset) };
+				if (distanceSquared >= closestDistanceSquared) continue;
+
+				const int otherCell{ m_pGrid->GetCellIndex(column + columnOffset, row + rowOffset) };
+				if ((otherCell != -1) && (m_Dangerous[otherCell] != dangerous)) closestDistanceSquared = distanceSquared;
+			}
+		}
+
+		const float distance{ sqrtf(float(closestDistanceSquared)) };
+		const float safety{ dangerous ? -distance : distance };
+		if (safety == m_Safeties[cell]) return;
+
+		m_Safeties[cell] = safety;
+		RefreshDirection(cell);
+		m_pGrid->ForEachNeighbour(cell, [this](int neighbour) -> void { RefreshDirection(neighbour); });
+	}
+
+	void FlowField::RefreshDirection(int cell)
+	{
+		// Far enough from all danger, no need to go anywhere
+		if (m_Safeties[cell] >= float(m_SafeCells))
+		{
+			m_Directions[cell] = Elite::Vector2{};
+			return;
+		}
+
+		// Follow the safety gradient over our neighbours
+		const int column{ m_pGrid->GetColumn(cell) };
+		const int row{ m_pGrid->GetRow(cell) };
+		Elite::Vector2 direction{};
+		m_pGrid->ForEachNeighbour(cell, [this, cell, column, row, &direction](int neighbour) -> void
+			{
+				const Elite::Vector2 offset{ float(m_pGrid->GetColumn(neighbour) - column), float(m_pGrid->GetRow(neighbour) - row) };
+				direction += offset.GetNormalized() * (m_Safeties[neighbour] - m_Safeties[cell]);
+			});
+
+		direction.Normalize();
+		m_Directions[cell] = direction;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef FLOW_FIELD
+#define FLOW_FIELD
+
+#include <vector>
+
+namespace Navigation
+{
+	class NavigationGrid;
+
+	// Per cell direction away from danger on top of the navigation grid, only the regions around changed danger get recalculated
+	class FlowField final
+	{
+	public:
+		explicit FlowField(const NavigationGrid* pGrid, float safeDistance = 40.0f, float dangerThreshold = 1.0f);
+		~FlowField() = default;
+
+		FlowField(const FlowField&) = delete;
+		FlowField& operator=(const FlowField&) = delete;
+		FlowField(FlowField&&) = delete;
+		FlowField& operator=(FlowField&&) = delete;
+
+		// Purge zones are remembered for their life time, seeing a zone again refreshes it
+		void AddPurgeZone(const Elite::Vector2& center, float radius, float lifeTime = 10.0f);
+
+		// Picks up the changed grid cells and recalculates dirty cells until the budget in microseconds is used up
+		void Update(float deltaTime, long long budget);
+
+		const Elite::Vector2& GetDirection(const Elite::Vector2& position) const;
+		float GetSafety(const Elite::Vector2& position) const;
+		bool IsUpToDate() const;
+
+	private:
+		struct PurgeZone final
+		{
+			Elite::Vector2 center;
+			float radius;
+			float lifeTime;
+		};
+
+		const NavigationGrid* m_pGrid;
+		int m_SafeCells;
+		float m_DangerThreshold;
+		std::vector<PurgeZone> m_PurgeZones;
+
+		// Per cell data, the safety is the distance in cells to the closest danger and negative inside danger
+		std::vector<unsigned char> m_ZoneCounts;
+		std::vector<bool> m_Dangerous;
+		std::vector<float> m_Safeties;
+		std::vector<Elite::Vector2> m_Directions;
+
+		// Cells that might have become (un)dangerous and cells whose safety has to be recalculated
+		std::vector<int> m_DirtySources;
+		std::vector<int> m_DirtyCells;
+		std::vector<bool> m_InDirtyCells;
+		size_t m_NextDirtyCell;
+
+		void MarkZone(const PurgeZone& zone, int change);
+		void RefreshSource(int cell);
+		void RefreshSafety(int cell);
+		void RefreshDirection(int cell);
+	};
+}
+
+#endif
\ No newline at end of file
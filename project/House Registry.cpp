@@ -0,0 +1,131 @@
+#include "stdafx.h"
+#include "House Registry.h"
+
+namespace Memory
+{
+	HouseRegistry::HouseRegistry(const WorldInfo& worldInfo) :
+		m_Ids{ 64 },
+		m_Centers{},
+		m_Sizes{},
+		m_Explored{},
+		m_Entrances{},
+		m_Items{},
+		m_ItemHouses{ 256 },
+		m_Grid{ worldInfo },
+		m_QueryResult{}
+	{
+
+	}
+
+	int HouseRegistry::Find(const HouseInfo& house) const
+	{
+		const int* pId{ m_Ids.Find(house) };
+		return (pId != nullptr) ? *pId : InvalidId;
+	}
+
+	int HouseRegistry::Add(const HouseInfo& house, const Elite::Vector2& entrance)
+	{
+		const int id{ Find(house) };
+		if (id != InvalidId) return id;
+
+		m_Ids.Insert(house, GetCount());
+		m_Centers.push_back(house.Center);
+		m_Sizes.push_back(house.Size);
+		m_Explored.push_back(false);
+		m_Entrances.push_back(entrance);
+		m_Items.emplace_back();
+		m_Grid.Insert(GetCount() - 1, house.Center, house.Size);
+
+		return GetCount() - 1;
+	}
+
+	int HouseRegistry::GetCount() const
+	{
+		return int(m_Centers.size());
+	}
+
+	const Elite::Vector2& HouseRegistry::GetCenter(int id) const
+	{
+		return m_Centers[id];
+	}
+
+	const Elite::Vector2& HouseRegistry::GetSize(int id) const
+	{
+		return m_Sizes[id];
+	}
+
+	bool HouseRegistry::Contains(int id, const Elite::Vector2& position) const
+	{
+		const Elite::Vector2 halfSize{ m_Sizes[id] / 2.0f };
+		const Elite::Vector2& center{ m_Centers[id] };
+
+		return (position.x >= (center.x - halfSize.x)) && (position.x <= (center.x + halfSize.x)) && (position.y >= (center.y - halfSize.y)) && (position.y <= (center.y + halfSize.y));
+	}
+
+	bool HouseRegistry::IsExplored(int id) const
+	{
+		return m_Explored[id];
+	}
+
+	void HouseRegistry::SetExplored(int id, bool explored)
+	{
+		m_Explored[id] = explored;
+	}
+
+	void HouseRegistry::ResetExplored()
+	{
+		std::fill(std::begin(m_Explored), std::end(m_Explored), false);
+	}
+
+	const Elite::Vector2& HouseRegistry::GetEntrance(int id) const
+	{
+		return m_Entrances[id];
+	}
+
+	void HouseRegistry::SetEntrance(int id, const Elite::Vector2& entrance)
+	{
+		m_Entrances[id] = entrance;
+	}
+
+	void HouseRegistry::QueryRectangle(const Elite::Vector2& minimum, const Elite::Vector2& maximum, std::vector<int>& ids) const
+	{
+		m_Grid.QueryRectangle(minimum, maximum, ids);
+	}
+
+	void HouseRegistry::QueryRadius(const Elite::Vector2& position, float radius, std::vector<int>& ids) const
+	{
+		m_Grid.QueryRadius(position, radius, ids);
+	}
+
+	void HouseRegistry::QueryNearestUnexplored(const Elite::Vector2& position, size_t count, std::vector<int>& ids) const
+	{
+		m_Grid.QueryNearest(position, count, ids, [this](int id) -> bool { return !m_Explored[id]; });
+	}
+
+	int HouseRegistry::FindNearestUnexplored(const Elite::Vector2& position) const
+	{
+		m_QueryResult.clear();
+		QueryNearestUnexplored(position, 1, m_QueryResult);
+
+		return m_QueryResult.empty() ? InvalidId : m_QueryResult.front();
+	}
+
+	const std::vector<ItemInfo>& HouseRegistry::GetItems(int id) const
+	{
+		return m_Items[id];
+	}
+
+	void HouseRegistry::AddItem(int id, const ItemInfo& item)
+	{
+		if (m_ItemHouses.Insert(item, id)) m_Items[id].push_back(item);
+	}
+
+	void HouseRegistry::RemoveItem(const ItemInfo& item)
+	{
+		const int* pHouse{ m_ItemHouses.Find(item) };
+		if (pHouse == nullptr) return;
+
+		std::erase(m_Items[*pHouse], item);
+		m_ItemHouses.Erase(item);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef HOUSE_REGISTRY
+#define HOUSE_REGISTRY
+
+#include "Exam_HelperStructs.h"
+#include "Flat Hash Map.h"
+#include "Spatial Grid.h"
+#include <vector>
+
+namespace Memory
+{
+	// Every house we found, stored per field and indexed by an id that never changes
+	class HouseRegistry final
+	{
+	public:
+		static constexpr int InvalidId{ -1 };
+
+		explicit HouseRegistry(const WorldInfo& worldInfo);
+		~HouseRegistry() = default;
+
+		HouseRegistry(const HouseRegistry&) = delete;
+		HouseRegistry& operator=(const HouseRegistry&) = delete;
+		HouseRegistry(HouseRegistry&&) = delete;
+		HouseRegistry& operator=(HouseRegistry&&) = delete;
+
+		// Returns the id of the house or InvalidId if we never found it
+		int Find(const HouseInfo& house) const;
+		// Returns the id of the new house, or of the existing one if we already found it
+		int Add(const HouseInfo& house, const Elite::Vector2& entrance);
+		int GetCount() const;
+
+		const Elite::Vector2& GetCenter(int id) const;
+		const Elite::Vector2& GetSize(int id) const;
+		bool Contains(int id, const Elite::Vector2& position) const;
+
+		bool IsExplored(int id) const;
+		void SetExplored(int id, bool explored);
+		// A new wave spawns new items, so every house is worth a visit again
+		void ResetExplored();
+
+		const Elite::Vector2& GetEntrance(int id) const;
+		void SetEntrance(int id, const Elite::Vector2& entrance);
+
+		// Spatial queries over every house we found, they add the ids they find to ids
+		void QueryRectangle(const Elite::Vector2& minimum, const Elite::Vector2& maximum, std::vector<int>& ids) const;
+		void QueryRadius(const Elite::Vector2& position, float radius, std::vector<int>& ids) const;
+		void QueryNearestUnexplored(const Elite::Vector2& position, size_t count, std::vector<int>& ids) const;
+		// Returns InvalidId when every house we know is explored
+		int FindNearestUnexplored(const Elite::Vector2& position) const;
+
+		// The items we saw in the house but didn't pick up yet, an item stays with the house we first saw it from
+		const std::vector<ItemInfo>& GetItems(int id) const;
+		void AddItem(int id, const ItemInfo& item);
+		// Removes the item from whichever house holds it, that isn't always the one we are in
+		void RemoveItem(const ItemInfo& item);
+
+	private:
+		Containers::FlatHashMap<HouseInfo, int> m_Ids;
+		std::vector<Elite::Vector2> m_Centers;
+		std::vector<Elite::Vector2> m_Sizes;
+		std::vector<bool> m_Explored;
+		std::vector<Elite::Vector2> m_Entrances;
+		std::vector<std::vector<ItemInfo>> m_Items;
+		// The house holding every item in any of the item lists, so we know if and where we saw an item before without searching the lists
+		Containers::FlatHashMap<ItemInfo, int> m_ItemHouses;
+		SpatialGrid m_Grid;
+		mutable std::vector<int> m_QueryResult;
+	};
+}
+
+#endif
\ No newline at end of file
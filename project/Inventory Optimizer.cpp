@@ -0,0 +1,110 @@
+#include "stdafx.h"
+#include "Inventory Optimizer.h"
+#include <bit>
+
+namespace DecisionMaking
+{
+	InventoryOptimizer::InventoryOptimizer(float decay, float minimumGain) :
+		m_Decay{ decay },
+		m_MinimumGain{ minimumGain }
+	{
+
+	}
+
+	bool InventoryOptimizer::FindBestAction(const Memory::Inventory& inventory, std::span<const ItemInfo> candidates, float difficulty, Action& action) const
+	{
+		// Score every type once, a swap only changes the types of the dropped and the added item
+		std::array<float, Memory::Inventory::TypeCount> typeScores{};
+		for (size_t type{}; type < Memory::Inventory::TypeCount; ++type) typeScores[type] = GetTypeScore(inventory, eItemType(type), Memory::Inventory::InvalidSlot, nullptr, difficulty);
+
+		Action bestAction{};
+		bestAction.gain = m_MinimumGain;
+		for (size_t candidate{}; candidate < candidates.size(); ++candidate)
+		{
+			const ItemInfo& item{ candidates[candidate] };
+			const size_t itemType{ size_t(item.Type) };
+			if ((itemType >= Memory::Inventory::TypeCount) || (GetValue(item, difficulty) <= 0.0f)) continue;
+
+			const float addedGain{ GetTypeScore(inventory, item.Type, Memory::Inventory::InvalidSlot, &item, difficulty) - typeScores[itemType] };
+			if (inventory.HasEmptySlot() && (addedGain > bestAction.gain)) bestAction = Action{ int(candidate), Memory::Inventory::InvalidSlot, addedGain };
+
+			for (UINT slot{}; slot < inventory.GetCapacity(); ++slot)
+			{
+				if (inventory.IsEmpty(slot)) continue;
+
+				const eItemType droppedType{ inventory.GetItem(slot).Type };
+				const float gain{ (droppedType == item.Type)
+					? GetTypeScore(inventory, droppedType, int(slot), &item, difficulty) - typeScores[itemType]
+					: GetTypeScore(inventory, droppedType, int(slot), nullptr, difficulty) - typeScores[size_t(droppedType)] + addedGain };
+
+				if (gain > bestAction.gain) bestAction = Action{ int(candidate), int(slot), gain };
+			}
+		}
+
+		if (bestAction.candidate == Memory::Inventory::InvalidSlot) return false;
+
+		action = bestAction;
+		return true;
+	}
+
+	int InventoryOptimizer::FindUselessSlot(const Memory::Inventory& inventory, float difficulty) const
+	{
+		for (UINT slot{}; slot < inventory.GetCapacity(); ++slot)
+		{
+			if (!inventory.IsEmpty(slot) && (GetValue(inventory.GetItem(slot), difficulty) <= 0.0f)) return int(slot);
+		}
+
+		return Memory::Inventory::InvalidSlot;
+	}
+
+	float InventoryOptimizer::GetValue(const ItemInfo& item, float difficulty) const
+	{
+		// Per bullet, health or energy point, harder stages have more zombies so bullets and healing become worth more
+		switch (item.Type)
+		{
+		case eItemType::PISTOL:
+			return float(std::max(item.Value, 0)) * (1.0f + difficulty);
+		case eItemType::SHOTGUN:
+			return float(std::max(item.Value, 0)) * 1.5f * (1.0f + difficulty);
+		case eItemType::MEDKIT:
+			return float(std::max(item.Value, 0)) * (1.0f + (0.5f * difficulty));
+		case eItemType::FOOD:
+			return float(std::max(item.Value, 0));
+		default:
+			return 0.0f;
+		}
+	}
+
+	float InventoryOptimizer::GetScore(const Memory::Inventory& inventory, float difficulty) const
+	{
+		float score{};
+		for (size_t type{}; type < Memory::Inventory::TypeCount; ++type) score += GetTypeScore(inventory, eItemType(type), Memory::Inventory::InvalidSlot, nullptr, difficulty);
+
+		return score;
+	}
+
+	float InventoryOptimizer::GetTypeScore(const Memory::Inventory& inventory, eItemType type, int droppedSlot, const ItemInfo* pAddedItem, float difficulty) const
+	{
+		// The values on the stack, at most one per slot plus the added item
+		std::array<float, Memory::Inventory::MaximumCapacity + 1> values{};
+		size_t count{};
+		for (uint32_t slots{ inventory.GetSlots(type) }; slots != 0; slots &= slots - 1)
+		{
+			const int slot{ std::countr_zero(slots) };
+			if (slot != droppedSlot) values[count++] = GetValue(inventory.GetItem(UINT(slot)), difficulty);
+		}
+		if ((pAddedItem != nullptr) && (pAddedItem->Type == type)) values[count++] = GetValue(*pAddedItem, difficulty);
+
+		// Best first, every next one of the same type adds less
+		std::sort(std::begin(values), std::begin(values) + count, std::greater<float>{});
+		float score{};
+		float weight{ 1.0f };
+		for (size_t index{}; index < count; ++index)
+		{
+			score += values[index] * weight;
+			weight *= m_Decay;
+		}
+
+		return score;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef INVENTORY_OPTIMIZER
+#define INVENTORY_OPTIMIZER
+
+#include "Exam_HelperStructs.h"
+#include "Inventory.h"
+#include <array>
+#include <span>
+
+namespace DecisionMaking
+{
+	// Scores what we carry against the items we could pick up and finds the swap or drop that improves it the most
+	class InventoryOptimizer final
+	{
+	public:
+		// What to do, pick up the candidate (InvalidSlot if none) after dropping the slot (InvalidSlot if none)
+		struct Action final
+		{
+			int candidate{ Memory::Inventory::InvalidSlot };
+			int dropSlot{ Memory::Inventory::InvalidSlot };
+			float gain{};
+		};
+
+		// The second item of a type is worth the decay times its value, the third decay squared and so on
+		InventoryOptimizer(float decay = 0.6f, float minimumGain = 1.0f);
+		~InventoryOptimizer() = default;
+
+		InventoryOptimizer(const InventoryOptimizer&) = delete;
+		InventoryOptimizer& operator=(const InventoryOptimizer&) = delete;
+		InventoryOptimizer(InventoryOptimizer&&) = delete;
+		InventoryOptimizer& operator=(InventoryOptimizer&&) = delete;
+
+		// Tries every candidate in every empty or full slot, false if nothing gains at least the minimum gain
+		bool FindBestAction(const Memory::Inventory& inventory, std::span<const ItemInfo> candidates, float difficulty, Action& action) const;
+		// A slot holding something worth nothing (a gun without ammo), InvalidSlot if there is none
+		int FindUselessSlot(const Memory::Inventory& inventory, float difficulty) const;
+
+		float GetValue(const ItemInfo& item, float difficulty) const;
+		float GetScore(const Memory::Inventory& inventory, float difficulty) const;
+
+	private:
+		float m_Decay;
+		float m_MinimumGain;
+
+		// Score of one type when the slot is dropped and the item is added, both optional
+		float GetTypeScore(const Memory::Inventory& inventory, eItemType type, int droppedSlot, const ItemInfo* pAddedItem, float difficulty) const;
+	};
+}
+
+#endif
\ No newline at end of file
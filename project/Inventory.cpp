@@ -0,0 +1,122 @@
+#include "stdafx.h"
+#include "Inventory.h"
+#include "IExamInterface.h"
+#include <bit>
+
+namespace Memory
+{
+	Inventory::Inventory(IExamInterface* pInterface) :
+		m_pInterface{ pInterface },
+		m_Capacity{ (pInterface != nullptr) ? std::min(pInterface->Inventory_GetCapacity(), MaximumCapacity) : 5 },
+		m_Items{},
+		m_TypeSlots{},
+		m_EmptySlots{}
+	{
+		m_Items.fill(ItemInfo{ eItemType::GARBAGE });
+		m_EmptySlots = (m_Capacity == 32) ? UINT32_MAX : ((uint32_t{ 1 } << m_Capacity) - 1);
+	}
+
+	bool Inventory::Add(UINT slot, const ItemInfo& item)
+	{
+		if ((slot >= m_Capacity) || !IsEmpty(slot) || (size_t(item.Type) >= TypeCount) || (item.Type == eItemType::GARBAGE)) return false;
+		if (!m_pInterface->Inventory_AddItem(slot, item)) return false;
+
+		m_Items[slot] = item;
+		m_TypeSlots[size_t(item.Type)] |= uint32_t{ 1 } << slot;
+		m_EmptySlots &= ~(uint32_t{ 1 } << slot);
+		return true;
+	}
+
+	bool Inventory::Use(UINT slot)
+	{
+		if ((slot >= m_Capacity) || IsEmpty(slot)) return false;
+		if (!m_pInterface->Inventory_UseItem(slot)) return false;
+
+		ItemInfo& item{ m_Items[slot] };
+		const bool isWeapon{ (item.Type == eItemType::PISTOL) || (item.Type == eItemType::SHOTGUN) };
+		if (isWeapon) --item.Value;
+		if (!isWeapon || (item.Value <= 0)) Remove(slot);
+
+		return true;
+	}
+
+	bool Inventory::Remove(UINT slot)
+	{
+		if ((slot >= m_Capacity) || IsEmpty(slot)) return false;
+		if (!m_pInterface->Inventory_RemoveItem(slot)) return false;
+
+		Clear(slot);
+		return true;
+	}
+
+	UINT Inventory::GetCapacity() const
+	{
+		return m_Capacity;
+	}
+
+	const ItemInfo& Inventory::GetItem(UINT slot) const
+	{
+		return m_Items[slot];
+	}
+
+	bool Inventory::IsEmpty(UINT slot) const
+	{
+		return (m_EmptySlots & (uint32_t{ 1 } << slot)) != 0;
+	}
+
+	bool Inventory::Has(eItemType type) const
+	{
+		return GetSlots(type) != 0;
+	}
+
+	int Inventory::GetCount(eItemType type) const
+	{
+		return std::popcount(GetSlots(type));
+	}
+
+	int Inventory::GetFirstSlot(eItemType type) const
+	{
+		const uint32_t slots{ GetSlots(type) };
+		return (slots != 0) ? std::countr_zero(slots) : InvalidSlot;
+	}
+
+	int Inventory::GetBestSlot(eItemType type) const
+	{
+		// Only walks the slots that hold the type
+		int bestSlot{ InvalidSlot };
+		for (uint32_t slots{ GetSlots(type) }; slots != 0; slots &= slots - 1)
+		{
+			const int slot{ std::countr_zero(slots) };
+			if ((bestSlot == InvalidSlot) || (m_Items[slot].Value > m_Items[bestSlot].Value)) bestSlot = slot;
+		}
+
+		return bestSlot;
+	}
+
+	uint32_t Inventory::GetSlots(eItemType type) const
+	{
+		return (size_t(type) < TypeCount) ? m_TypeSlots[size_t(type)] : 0;
+	}
+
+	bool Inventory::HasEmptySlot() const
+	{
+		return m_EmptySlots != 0;
+	}
+
+	int Inventory::GetFirstEmptySlot() const
+	{
+		return (m_EmptySlots != 0) ? std::countr_zero(m_EmptySlots) : InvalidSlot;
+	}
+
+	uint32_t Inventory::GetEmptySlots() const
+	{
+		return m_EmptySlots;
+	}
+
+	void Inventory::Clear(UINT slot)
+	{
+		m_TypeSlots[size_t(m_Items[slot].Type)] &= ~(uint32_t{ 1 } << slot);
+		m_EmptySlots |= uint32_t{ 1 } << slot;
+		m_Items[slot] = ItemInfo{ eItemType::GARBAGE };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef INVENTORY
+#define INVENTORY
+
+#include "Exam_HelperStructs.h"
+#include <array>
+#include <cstdint>
+
+class IExamInterface;
+
+namespace Memory
+{
+	// Our copy of the inventory with a bitmask of the slots holding every item type, so what we carry is a bit operation away
+	class Inventory final
+	{
+	public:
+		static constexpr int InvalidSlot{ -1 };
+		static constexpr UINT MaximumCapacity{ 32 };
+		static constexpr size_t TypeCount{ size_t(eItemType::_LAST) + 1 };
+
+		explicit Inventory(IExamInterface* pInterface);
+		~Inventory() = default;
+
+		Inventory(const Inventory&) = delete;
+		Inventory& operator=(const Inventory&) = delete;
+		Inventory(Inventory&&) = delete;
+		Inventory& operator=(Inventory&&) = delete;
+
+		// These go through the interface and only change our copy when it succeeded
+		bool Add(UINT slot, const ItemInfo& item);
+		// Guns lose a bullet and get thrown away once empty, medkits and food are used up at once
+		bool Use(UINT slot);
+		bool Remove(UINT slot);
+
+		UINT GetCapacity() const;
+		const ItemInfo& GetItem(UINT slot) const;
+		bool IsEmpty(UINT slot) const;
+
+		bool Has(eItemType type) const;
+		int GetCount(eItemType type) const;
+		// Lowest slot holding the type, InvalidSlot if there is none
+		int GetFirstSlot(eItemType type) const;
+		// Slot of the type with the highest value (ammo, health or energy), InvalidSlot if there is none
+		int GetBestSlot(eItemType type) const;
+		uint32_t GetSlots(eItemType type) const;
+
+		bool HasEmptySlot() const;
+		int GetFirstEmptySlot() const;
+		uint32_t GetEmptySlots() const;
+
+	private:
+		IExamInterface* m_pInterface;
+		UINT m_Capacity;
+		std::array<ItemInfo, MaximumCapacity> m_Items;
+		// Bit n is set when slot n holds the type, garbage never stays in the inventory so it has no mask
+		std::array<uint32_t, TypeCount> m_TypeSlots;
+		uint32_t m_EmptySlots;
+
+		void Clear(UINT slot);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "stdafx.h"
+#include "Item Memory.h"
+
+namespace Memory
+{
+	namespace
+	{
+		constexpr int IndexBits{ 24 };
+		constexpr int IndexMask{ (1 << IndexBits) - 1 };
+	}
+
+	ItemMemory::ItemMemory() :
+		m_Buckets{},
+		m_Locations{ 512 },
+		m_Frame{ 0 }
+	{
+
+	}
+
+	void ItemMemory::Observe(const AgentInfo& agentInfo, std::span<const ItemInfo> visibleItems)
+	{
+		++m_Frame;
+		std::ranges::for_each(visibleItems, [this](const ItemInfo& item) -> void { Add(item); });
+
+		// An item that was somewhere we are looking at now but isn't reported anymore is gone, stay a bit inside the cone to be sure
+		const Elite::Vector2 forward{ Elite::OrientationToVector(agentInfo.Orientation) };
+		const float range{ agentInfo.FOV_Range * 0.9f };
+		const float cosine{ cosf(agentInfo.FOV_Angle * 0.45f) };
+
+		for (size_t type{}; type < TypeCount; ++type)
+		{
+			Bucket& bucket{ m_Buckets[type] };
+			for (size_t index{}; index < bucket.itemHashes.size();)
+			{
+				const float offsetX{ bucket.positionsX[index] - agentInfo.Position.x };
+				const float offsetY{ bucket.positionsY[index] - agentInfo.Position.y };
+				const float distance{ sqrtf((offsetX * offsetX) + (offsetY * offsetY)) };
+				const bool shouldBeVisible{ (distance < range) && (((offsetX * forward.x) + (offsetY * forward.y)) >= (cosine * distance)) };
+
+				if (shouldBeVisible && (bucket.seenFrames[index] != m_Frame)) RemoveAt(type, index);
+				else ++index;
+			}
+		}
+	}
+
+	void ItemMemory::Add(const ItemInfo& item)
+	{
+		const size_t type{ size_t(item.Type) };
+		if (type >= TypeCount) return;
+
+		// A known item only gets its data refreshed, items never change type
+		Bucket& bucket{ m_Buckets[type] };
+		const int* pLocation{ m_Locations.Find(item.ItemHash) };
+		size_t index{};
+		if (pLocation != nullptr)
+		{
+			index = size_t(*pLocation & IndexMask);
+		}
+		else
+		{
+			index = bucket.itemHashes.size();
+			bucket.positionsX.push_back(0.0f);
+			bucket.positionsY.push_back(0.0f);
+			bucket.values.push_back(0);
+			bucket.itemHashes.push_back(item.ItemHash);
+			bucket.seenFrames.push_back(0);
+			m_Locations.Insert(item.ItemHash, (int(type) << IndexBits) | int(index));
+		}
+
+		bucket.positionsX[index] = item.Location.x;
+		bucket.positionsY[index] = item.Location.y;
+		bucket.values[index] = item.Value;
+		bucket.seenFrames[index] = m_Frame;
+	}
+
+	void ItemMemory::Remove(int itemHash)
+	{
+		const int* pLocation{ m_Locations.Find(itemHash) };
+		if (pLocation != nullptr) RemoveAt(size_t(*pLocation >> IndexBits), size_t(*pLocation & IndexMask));
+	}
+
+	size_t ItemMemory::GetCount() const
+	{
+		return m_Locations.Size();
+	}
+
+	size_t ItemMemory::GetCount(eItemType type) const
+	{
+		return m_Buckets[size_t(type)].itemHashes.size();
+	}
+
+	bool ItemMemory::Contains(int itemHash) const
+	{
+		return m_Locations.Contains(itemHash);
+	}
+
+	bool ItemMemory::FindClosest(eItemType type, const Elite::Vector2& position, float maximumDistance, int minimumValue, ItemInfo& item) const
+	{
+		float distanceSquared{};
+		const int index{ FindClosestIndex(size_t(type), position, maximumDistance * maximumDistance, minimumValue, distanceSquared) };
+		if (index == -1) return false;
+
+		item = GetItem(size_t(type), size_t(index));
+		return true;
+	}
+
+	bool ItemMemory::FindClosestLoadedWeapon(const Elite::Vector2& position, float maximumDistance, ItemInfo& item) const
+	{
+		float pistolDistanceSquared{}, shotgunDistanceSquared{};
+		const int pistol{ FindClosestIndex(size_t(eItemType::PISTOL), position, maximumDistance * maximumDistance, 1, pistolDistanceSquared) };
+		const int shotgun{ FindClosestIndex(size_t(eItemType::SHOTGUN), position, maximumDistance * maximumDistance, 1, shotgunDistanceSquared) };
+
+		if ((pistol == -1) && (shotgun == -1)) return false;
+
+		if ((shotgun == -1) || ((pistol != -1) && (pistolDistanceSquared <= shotgunDistanceSquared))) item = GetItem(size_t(eItemType::PISTOL), size_t(pistol));
+		else item = GetItem(size_t(eItemType::SHOTGUN), size_t(shotgun));
+		return true;
+	}
+
+	void ItemMemory::RemoveAt(size_t type, size_t index)
+	{
+		// Move the last item of the bucket into the hole so the bucket stays packed
+		Bucket& bucket{ m_Buckets[type] };
+		m_Locations.Erase(bucket.itemHashes[index]);
+
+		const size_t last{ bucket.itemHashes.size() - 1 };
+		if (index != last)
+		{
+			bucket.positionsX[index] = bucket.positionsX[last];
+			bucket.positionsY[index] = bucket.positionsY[last];
+			bucket.values[index] = bucket.values[last];
+			bucket.itemHashes[index] = bucket.itemHashes[last];
+			bucket.seenFrames[index] = bucket.seenFrames[last];
+			*m_Locations.Find(bucket.itemHashes[index]) = (int(type) << IndexBits) | int(index);
+		}
+
+		bucket.positionsX.pop_back();
+		bucket.positionsY.pop_back();
+		bucket.values.pop_back();
+		bucket.itemHashes.pop_back();
+		bucket.seenFrames.pop_back();
+	}
+
+	int ItemMemory::FindClosestIndex(size_t type, const Elite::Vector2& position, float maximumDistanceSquared, int minimumValue, float& distanceSquared) const
+	{
+		// A bucket holds at most a couple of hundred items, a straight scan over the packed positions beats any tree at that size
+		const Bucket& bucket{ m_Buckets[type] };
+		int closest{ -1 };
+		distanceSquared = maximumDistanceSquared;
+
+		for (size_t index{}; index < bucket.itemHashes.size(); ++index)
+		{
+			const float offsetX{ bucket.positionsX[index] - position.x };
+			const float offsetY{ bucket.positionsY[index] - position.y };
+			const float itemDistanceSquared{ (offsetX * offsetX) + (offsetY * offsetY) };
+			if ((itemDistanceSquared < distanceSquared) && (bucket.values[index] >= minimumValue))
+			{
+				distanceSquared = itemDistanceSquared;
+				closest = int(index);
+			}
+		}
+
+		return closest;
+	}
+
+	ItemInfo ItemMemory::GetItem(size_t type, size_t index) const
+	{
+		const Bucket& bucket{ m_Buckets[type] };
+		return ItemInfo{ eItemType(type), Elite::Vector2{ bucket.positionsX[index], bucket.positionsY[index] }, bucket.itemHashes[index], bucket.values[index] };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef ITEM_MEMORY
+#define ITEM_MEMORY
+
+#include "Exam_HelperStructs.h"
+#include "Flat Hash Map.h"
+#include <array>
+#include <vector>
+#include <span>
+
+namespace Memory
+{
+	// Every item we saw anywhere in the world, per type, until we pick it up or see it is gone
+	class ItemMemory final
+	{
+	public:
+		static constexpr size_t TypeCount{ size_t(eItemType::_LAST) + 1 };
+
+		ItemMemory();
+		~ItemMemory() = default;
+
+		ItemMemory(const ItemMemory&) = delete;
+		ItemMemory& operator=(const ItemMemory&) = delete;
+		ItemMemory(ItemMemory&&) = delete;
+		ItemMemory& operator=(ItemMemory&&) = delete;
+
+		// Stores the items we see now and forgets the ones that should be in our field of view but aren't
+		void Observe(const AgentInfo& agentInfo, std::span<const ItemInfo> visibleItems);
+		void Add(const ItemInfo& item);
+		void Remove(int itemHash);
+
+		size_t GetCount() const;
+		size_t GetCount(eItemType type) const;
+		bool Contains(int itemHash) const;
+
+		// Closest item of the type within the distance with at least the value, false if there is none
+		bool FindClosest(eItemType type, const Elite::Vector2& position, float maximumDistance, int minimumValue, ItemInfo& item) const;
+		// Closest pistol or shotgun that still has ammo
+		bool FindClosestLoadedWeapon(const Elite::Vector2& position, float maximumDistance, ItemInfo& item) const;
+
+	private:
+		// One bucket per item type, one element per item
+		struct Bucket final
+		{
+			std::vector<float> positionsX;
+			std::vector<float> positionsY;
+			std::vector<int> values;
+			std::vector<int> itemHashes;
+			std::vector<unsigned int> seenFrames;
+		};
+
+		std::array<Bucket, TypeCount> m_Buckets;
+		// Item hash to the type in the high bits and the index in its bucket in the low bits
+		Containers::FlatHashMap<int, int> m_Locations;
+		unsigned int m_Frame;
+
+		void RemoveAt(size_t type, size_t index);
+		int FindClosestIndex(size_t type, const Elite::Vector2& position, float maximumDistanceSquared, int minimumValue, float& distanceSquared) const;
+		ItemInfo GetItem(size_t type, size_t index) const;
+	};
+}
+
+#endif
\ No newline at end of file
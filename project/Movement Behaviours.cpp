@@ -1,39 +1,50 @@
 #include "stdafx.h"
 #include "Movement Behaviours.h"
-#include "IExamInterface.h"
 #include <numeric>
+#include <array>
 
 namespace MovementBehavior
 {
 #pragma region ISteeringBehavior
-	std::function<Elite::Vector2(Elite::Vector2)> ISteeringBehavior::m_PathfindingFunction{};
+	ISteeringBehavior::ISteeringBehavior(const PathFunctions& pathFunctions) :
+		m_PathFunctions{ pathFunctions },
+		m_SmoothingHistory{}
+	{
+
+	}
 
-	void ISteeringBehavior::SetPathfindingFunction(IExamInterface* pInterface, std::function<Elite::Vector2(IExamInterface*, Elite::Vector2)> function)
+	Elite::Vector2 ISteeringBehavior::GetPathPoint(const Elite::Vector2& position, const Elite::Vector2& target)
 	{
-		m_PathfindingFunction = std::bind(function, pInterface, std::placeholders::_1);
+		const Elite::Vector2 pathPoint{ m_PathFunctions.pathfinding(target) };
+		if (!m_PathFunctions.smoothing) return pathPoint;
+
+		return m_PathFunctions.smoothing(m_SmoothingHistory, position, pathPoint, target);
 	}
 
-	void ISteeringBehavior::OrientTo(float& angularVelocity, const AgentInfo& agentInfo, const Elite::Vector2& point)
+	void ISteeringBehavior::OrientTo(float& angularVelocity, float deltaT, const AgentInfo& agentInfo, const Elite::Vector2& point)
 	{
 		const Elite::Vector2 direction{ (point - agentInfo.Position) };
-		const float orientationDifference{ Elite::AngleBetween(direction, Elite::OrientationToVector(agentInfo.Orientation)) };
+		const float orientationDifference{ Elite::AngleBetween(Elite::OrientationToVector(agentInfo.Orientation), direction) };
 
-		if (!Elite::AreEqual(orientationDifference, 0.0f))
-		{
-			if (orientationDifference > 0.0f) angularVelocity = -agentInfo.MaxAngularSpeed;
-			else angularVelocity = agentInfo.MaxAngularSpeed;
-		}
-		else angularVelocity = 0.0f;
+		// Turn at full speed but never further than what is left this frame, so we don't swing past and flip back the next one
+		const float angularSpeed{ std::min(agentInfo.MaxAngularSpeed, std::abs(orientationDifference) / std::max(deltaT, FLT_MIN)) };
+		angularVelocity = std::copysign(angularSpeed, orientationDifference);
 	}
 #pragma endregion
 
 #pragma region Seek
+	Seek::Seek(const PathFunctions& pathFunctions) :
+		ISteeringBehavior(pathFunctions)
+	{
+
+	}
+
 	SteeringPlugin_Output Seek::CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData)
 	{
 		SteeringPlugin_Output steering{};
 
 		// Move towards the target
-		const Elite::Vector2 targetPosition{ m_PathfindingFunction(targetData.position) };						// Make this a reachable point
+		const Elite::Vector2 targetPosition{ GetPathPoint(agentInfo.Position, targetData.position) };			// Make this a reachable point
 		const Elite::Vector2 direction{ (targetPosition - agentInfo.Position).GetNormalized() };				// Towards the target position
 		steering.LinearVelocity = direction * agentInfo.MaxLinearSpeed;
 
@@ -46,6 +57,12 @@ namespace MovementBehavior
 #pragma endregion
 
 #pragma region Flee
+	Flee::Flee(const PathFunctions& pathFunctions) :
+		ISteeringBehavior(pathFunctions)
+	{
+
+	}
+
 	SteeringPlugin_Output Flee::CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData)
 	{
 		SteeringPlugin_Output steering{};
@@ -53,12 +70,12 @@ namespace MovementBehavior
 		// Move away from the target
 		Elite::Vector2 direction{ (agentInfo.Position - targetData.position).GetNormalized() };
 		Elite::Vector2 targetPosition{ agentInfo.Position + (direction * 6.0f) };
-		targetPosition = m_PathfindingFunction(targetPosition);
+		targetPosition = m_PathFunctions.pathfinding(targetPosition);
 		direction = (targetPosition - agentInfo.Position).GetNormalized();
 		steering.LinearVelocity = direction * agentInfo.MaxLinearSpeed;
 
 		// Look towards the target
-		OrientTo(steering.AngularVelocity, agentInfo, targetData.position);
+		OrientTo(steering.AngularVelocity, deltaT, agentInfo, targetData.position);
 		steering.AutoOrient = false;
 
 		return steering;
@@ -66,8 +83,8 @@ namespace MovementBehavior
 #pragma endregion
 
 #pragma region Arrive
-	Arrive::Arrive(float slowRadius, float targetRadius) :
-		ISteeringBehavior(),
+	Arrive::Arrive(const PathFunctions& pathFunctions, float slowRadius, float targetRadius) :
+		ISteeringBehavior(pathFunctions),
 		m_SlowRadius{ slowRadius },
 		m_TargetRadius{ targetRadius }
 	{
@@ -79,23 +96,18 @@ namespace MovementBehavior
 		SteeringPlugin_Output steering{};
 
 		// Move towards the target
-		Elite::Vector2 direction{ (targetData.position - agentInfo.Position).GetNormalized() };
-		Elite::Vector2 targetPosition{ agentInfo.Position + (direction * 1.0f) };
-		targetPosition = m_PathfindingFunction(targetPosition);
-		direction = (targetPosition - agentInfo.Position).GetNormalized();
+		const Elite::Vector2 targetPosition{ GetPathPoint(agentInfo.Position, targetData.position) };			// Make this a reachable point
+		const Elite::Vector2 direction{ (targetPosition - agentInfo.Position).GetNormalized() };				// Towards the target position
 
-		// Move faster when further away
+		// Brake with a constant deceleration so we are at full speed at the slow radius and standing still at the target radius
 		const float distance{ targetData.position.Distance(agentInfo.Position) };
-		float speed{ 0.0f };
-		if (distance < m_SlowRadius)
-		{
-			speed = agentInfo.MaxLinearSpeed * ((distance - m_TargetRadius) / (m_SlowRadius - m_TargetRadius));
-		}
-		else
-		{
-			speed = agentInfo.MaxLinearSpeed;
-		}
-		steering.LinearVelocity = direction.GetNormalized() * speed;
+		const float remainingDistance{ std::max(distance - m_TargetRadius, 0.0f) };
+		const float deceleration{ (agentInfo.MaxLinearSpeed * agentInfo.MaxLinearSpeed) / (2.0f * std::max(m_SlowRadius - m_TargetRadius, FLT_EPSILON)) };
+		float speed{ std::min(agentInfo.MaxLinearSpeed, sqrtf(2.0f * deceleration * remainingDistance)) };
+
+		// Never move further than what is left this frame, so long frames don't make us overshoot
+		if (deltaT > 0.0f) speed = std::min(speed, remainingDistance / deltaT);
+		steering.LinearVelocity = direction * speed;
 
 		// Look towards where you are going
 		steering.AngularVelocity = 0.0f;
@@ -116,6 +128,12 @@ namespace MovementBehavior
 #pragma endregion
 
 #pragma region Pursuit
+	Pursuit::Pursuit(const PathFunctions& pathFunctions) :
+		ISteeringBehavior(pathFunctions)
+	{
+
+	}
+
 	SteeringPlugin_Output Pursuit::CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData)
 	{
 		SteeringPlugin_Output steering{};
@@ -124,7 +142,7 @@ namespace MovementBehavior
 		const float distance{ targetData.position.Distance(agentInfo.Position) };						// Between target position and current position
 		const float time{ distance / agentInfo.MaxLinearSpeed };										// Time it takes us to travel that distance
 		Elite::Vector2 predictedPosition{ targetData.position + (time * targetData.velocity) };			// Where the target will be after that delta time
-		predictedPosition = m_PathfindingFunction(predictedPosition);									// Make sure this is a point on the nav mesh
+		predictedPosition = m_PathFunctions.pathfinding(predictedPosition);									// Make sure this is a point on the nav mesh
 		const Elite::Vector2 direction{ (predictedPosition - agentInfo.Position).GetNormalized() };		// Towards this predicted position
 		steering.LinearVelocity = direction * agentInfo.MaxLinearSpeed;
 
@@ -137,6 +155,12 @@ namespace MovementBehavior
 #pragma endregion
 
 #pragma region Evade
+	Evade::Evade(const PathFunctions& pathFunctions) :
+		ISteeringBehavior(pathFunctions)
+	{
+
+	}
+
 	SteeringPlugin_Output Evade::CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData)
 	{
 		SteeringPlugin_Output steering{};
@@ -145,12 +169,12 @@ namespace MovementBehavior
 		const float distance{ targetData.position.Distance(agentInfo.Position) };						    // Between target position and current position
 		const float time{ distance / agentInfo.MaxLinearSpeed };											// Time it takes us to travel that distance
 		Elite::Vector2 predictedPosition{ targetData.position + (targetData.velocity * time) };				// Where the target will be after that delta time
-		predictedPosition = m_PathfindingFunction(predictedPosition);										// Make sure this is a point on the nav mesh
+		predictedPosition = m_PathFunctions.pathfinding(predictedPosition);										// Make sure this is a point on the nav mesh
 		const Elite::Vector2 direction{ (agentInfo.Position - predictedPosition).GetNormalized() };			// Away from this predicted position
 		steering.LinearVelocity = direction * agentInfo.MaxLinearSpeed;
 
 		// Look at where you are going
-		OrientTo(steering.AngularVelocity, agentInfo, targetData.position);
+		OrientTo(steering.AngularVelocity, deltaT, agentInfo, targetData.position);
 		steering.AutoOrient = false;
 
 		return steering;
@@ -158,12 +182,15 @@ namespace MovementBehavior
 #pragma endregion
 
 #pragma region Wander
-	Wander::Wander(float offset, float radius, float maxAngleChangeDegrees) :
-		ISteeringBehavior(),
+	Wander::Wander(const PathFunctions& pathFunctions, float offset, float radius, float maxAngleChangeDegrees, uint32_t seed) :
+		ISteeringBehavior(pathFunctions),
 		m_WanderOffset{ offset },
 		m_WanderRadius{ radius },
 		m_MaxAngleChange{ Elite::ToRadians(maxAngleChangeDegrees) },
-		m_WanderAngle{ 0.0f }
+		m_WanderAngle{ 0.0f },
+		m_RandomGenerator{ seed },
+		m_AngleDeltas{},
+		m_NextAngleDelta{ m_AngleDeltas.size() }
 	{
 
 	}
@@ -175,13 +202,18 @@ namespace MovementBehavior
 		// Move towards a random position, but withtin a certain range away from you
 		const Elite::Vector2 directionAgent{ agentInfo.LinearVelocity.GetNormalized() };							// The current direction we are facing
 		const Elite::Vector2 centerCircle{ agentInfo.Position + (directionAgent * m_WanderOffset) };				// The center of the "wander" circle in front of us
-		m_WanderAngle += Elite::randomFloat(-m_MaxAngleChange, m_MaxAngleChange);									// A random angle change between set values
+		if (m_NextAngleDelta == m_AngleDeltas.size())																// Generate a new block of random angle changes when we used them all
+		{
+			GenerateAngleDeltas(m_AngleDeltas.data(), m_AngleDeltas.size());
+			m_NextAngleDelta = 0;
+		}
+		m_WanderAngle += m_AngleDeltas[m_NextAngleDelta++];															// A random angle change between set values
 		Elite::Vector2 targetPosition																				// A point on on the wander circle using the random angle
 		{
 			centerCircle.x + m_WanderRadius * cosf(m_WanderAngle),
 			centerCircle.y + m_WanderRadius * sinf(m_WanderAngle)
 		};
-		targetPosition = m_PathfindingFunction(targetPosition);														// Make sure this point is on the nav mesh
+		targetPosition = m_PathFunctions.pathfinding(targetPosition);														// Make sure this point is on the nav mesh
 		const Elite::Vector2 direction{ (targetPosition - agentInfo.Position).GetNormalized() };					// Towards this point on the circle	
 		steering.LinearVelocity = direction * agentInfo.MaxLinearSpeed;
 
@@ -211,6 +243,201 @@ namespace MovementBehavior
 	{
 		m_WanderAngle = angle;
 	}
+
+	void Wander::SetSeed(uint32_t seed)
+	{
+		m_RandomGenerator.Seed(seed);
+		m_NextAngleDelta = m_AngleDeltas.size();
+	}
+
+	void Wander::GenerateAngleDeltas(float* pAngleDeltas, size_t count)
+	{
+		m_RandomGenerator.FillFloats(pAngleDeltas, count, -m_MaxAngleChange, m_MaxAngleChange);
+	}
+#pragma endregion
+
+#pragma region ContextSteering
+	ContextSteering::ContextSteering(const PathFunctions& pathFunctions, int slotCount, float dangerRange, float dangerTolerance, float lookAheadDistance) :
+		ISteeringBehavior(pathFunctions),
+		m_SlotDirectionsX(slotCount),
+		m_SlotDirectionsY(slotCount),
+		m_Interest(slotCount, 0.0f),
+		m_Danger(slotCount, 0.0f),
+		m_DangerRange{ dangerRange },
+		m_DangerTolerance{ dangerTolerance },
+		m_LookAheadDistance{ lookAheadDistance }
+	{
+		// Spread the slots evenly around the agent
+		const float slotAngle{ (2.0f * float(E_PI)) / float(slotCount) };
+		for (int slot{}; slot < slotCount; ++slot)
+		{
+			m_SlotDirectionsX[slot] = cosf(slotAngle * float(slot));
+			m_SlotDirectionsY[slot] = sinf(slotAngle * float(slot));
+		}
+	}
+
+	SteeringPlugin_Output ContextSteering::CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData)
+	{
+		SteeringPlugin_Output steering{};
+
+		// Our target is always something we are interested in
+		AddInterest(agentInfo.Position, targetData.position);
+
+		const size_t slotCount{ m_Interest.size() };
+
+		// Mask every slot that is noticeably more dangerous than the safest slot
+		const float minimumDanger{ *std::min_element(std::begin(m_Danger), std::end(m_Danger)) };
+		const float dangerThreshold{ minimumDanger + m_DangerTolerance };
+		for (size_t slot{}; slot < slotCount; ++slot)
+		{
+			m_Interest[slot] = (m_Danger[slot] <= dangerThreshold) ? m_Interest[slot] : -1.0f;
+		}
+
+		// Go in the direction of the most interesting slot that is left
+		const size_t bestSlot{ size_t(std::distance(std::begin(m_Interest), std::max_element(std::begin(m_Interest), std::end(m_Interest)))) };
+		Elite::Vector2 direction{ m_SlotDirectionsX[bestSlot], m_SlotDirectionsY[bestSlot] };
+		const Elite::Vector2 targetPosition{ m_PathFunctions.pathfinding(agentInfo.Position + (direction * m_LookAheadDistance)) };		// Make this a reachable point
+		direction = (targetPosition - agentInfo.Position).GetNormalized();
+		steering.LinearVelocity = direction * agentInfo.MaxLinearSpeed;
+
+		// Look at the direction you are going
+		steering.AngularVelocity = 0.0f;
+		steering.AutoOrient = true;
+
+		ClearMaps();
+
+		return steering;
+	}
+
+	void ContextSteering::ClearMaps()
+	{
+		std::fill(std::begin(m_Interest), std::end(m_Interest), 0.0f);
+		std::fill(std::begin(m_Danger), std::end(m_Danger), 0.0f);
+	}
+
+	void ContextSteering::AddInterest(const Elite::Vector2& agentPosition, const Elite::Vector2& point, float weight)
+	{
+		const Elite::Vector2 direction{ (point - agentPosition).GetNormalized() };
+
+		// Slots facing the point are the most interesting, slots facing away still get a little bit so we always have a fallback
+		const size_t slotCount{ m_Interest.size() };
+		for (size_t slot{}; slot < slotCount; ++slot)
+		{
+			const float dot{ (m_SlotDirectionsX[slot] * direction.x) + (m_SlotDirectionsY[slot] * direction.y) };
+			m_Interest[slot] = std::max(m_Interest[slot], weight * ((dot + 1.0f) * 0.5f));
+		}
+	}
+
+	void ContextSteering::AddDanger(const Elite::Vector2& agentPosition, const Elite::Vector2& point, float radius, float weight)
+	{
+		const Elite::Vector2 toDanger{ point - agentPosition };
+		const float distance{ toDanger.Magnitude() };
+
+		// Danger fades out the further the edge of the danger is away from us
+		const float intensity{ weight * std::clamp(1.0f - ((distance - radius) / m_DangerRange), 0.0f, 1.0f) };
+		if (intensity <= 0.0f) return;
+
+		// The closer or bigger the danger the more slots it covers
+		const Elite::Vector2 direction{ toDanger.GetNormalized() };
+		const float spread{ (distance > radius) ? (radius / distance) : 1.0f };
+
+		const size_t slotCount{ m_Danger.size() };
+		for (size_t slot{}; slot < slotCount; ++slot)
+		{
+			const float dot{ (m_SlotDirectionsX[slot] * direction.x) + (m_SlotDirectionsY[slot] * direction.y) };
+			m_Danger[slot] = std::max(m_Danger[slot], intensity * std::max(0.0f, (dot + spread) / (1.0f + spread)));
+		}
+	}
+
+	void ContextSteering::AddDangerRectangle(const Elite::Vector2& agentPosition, const Elite::Vector2& center, const Elite::Vector2& size, float weight)
+	{
+		const Elite::Vector2 halfSize{ size / 2.0f };
+		const Elite::Vector2 closestPoint
+		{
+			std::clamp(agentPosition.x, center.x - halfSize.x, center.x + halfSize.x),
+			std::clamp(agentPosition.y, center.y - halfSize.y, center.y + halfSize.y)
+		};
+
+		// Walls only matter from the outside, inside the house the nav mesh keeps us away from them
+		if (closestPoint == agentPosition) return;
+
+		AddDanger(agentPosition, closestPoint, 0.0f, weight);
+	}
+#pragma endregion
+
+#pragma region Separation
+	Separation::Separation(float neighbourRadius, float wallRadius, float wallWeight) :
+		ISteeringBehavior(),
+		m_Neighbours{},
+		m_Walls{},
+		m_NeighbourRadius{ neighbourRadius },
+		m_WallRadius{ wallRadius },
+		m_WallWeight{ wallWeight }
+	{
+
+	}
+
+	SteeringPlugin_Output Separation::CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData)
+	{
+		SteeringPlugin_Output steering{};
+
+		// Push away from everything close to us, harder the closer it is
+		Elite::Vector2 force{};
+		const auto addRepulsion{ [&agentInfo, &force](const SpatialHash::Entry& entry, float range, float weight) -> void
+			{
+				Elite::Vector2 away{ agentInfo.Position - entry.position };
+				const float distance{ std::max(away.Normalize() - entry.radius, 0.0f) };
+				force += away * (weight * (1.0f - std::min(distance / range, 1.0f)));
+			} };
+
+		m_Neighbours.Query(agentInfo.Position, m_NeighbourRadius, [this, &addRepulsion](const SpatialHash::Entry& entry) -> void { addRepulsion(entry, m_NeighbourRadius, 1.0f); });
+		m_Walls.Query(agentInfo.Position, m_WallRadius, [this, &addRepulsion](const SpatialHash::Entry& entry) -> void { addRepulsion(entry, m_WallRadius, m_WallWeight); });
+
+		// Nothing close means no steering, so we don't water down other behaviours in a blend
+		const float strength{ std::min(force.Normalize(), 1.0f) };
+		steering.LinearVelocity = force * (agentInfo.MaxLinearSpeed * strength);
+
+		// Look at the direction you are going
+		steering.AngularVelocity = 0.0f;
+		steering.AutoOrient = true;
+
+		return steering;
+	}
+
+	void Separation::ClearNeighbours()
+	{
+		m_Neighbours.Clear();
+	}
+
+	void Separation::AddNeighbour(const Elite::Vector2& position, float radius)
+	{
+		m_Neighbours.Insert(position, radius);
+	}
+
+	void Separation::AddHouseWalls(const Elite::Vector2& center, const Elite::Vector2& size)
+	{
+		const Elite::Vector2 halfSize{ size / 2.0f };
+		const std::array<Elite::Vector2, 4> corners
+		{
+			Elite::Vector2{ center.x - halfSize.x, center.y - halfSize.y },
+			Elite::Vector2{ center.x + halfSize.x, center.y - halfSize.y },
+			Elite::Vector2{ center.x + halfSize.x, center.y + halfSize.y },
+			Elite::Vector2{ center.x - halfSize.x, center.y + halfSize.y }
+		};
+
+		// Sample points along every wall, close enough together that we can't slip between them
+		for (size_t corner{}; corner < corners.size(); ++corner)
+		{
+			const Elite::Vector2& start{ corners[corner] };
+			const Elite::Vector2& end{ corners[(corner + 1) % corners.size()] };
+			const int sampleCount{ std::max(int(ceilf(start.Distance(end) / m_WallRadius)), 1) };
+
+			for (int sample{}; sample < sampleCount; ++sample)
+			{
+				m_Walls.Insert(Elite::Lerp(start, end, float(sample) / float(sampleCount)));
+			}
+		}
+	}
 #pragma endregion
 
 #pragma region BlendedSteering
@@ -240,6 +467,9 @@ namespace MovementBehavior
 		{
 			const SteeringPlugin_Output steering{ weightedBehavior.first->CalculateSteering(deltaT, agentInfo, targetData) };
 
+			// Behaviours that have nothing to do this frame (like separation with nobody around) don't count
+			if ((steering.LinearVelocity == Elite::Vector2{}) && (steering.AngularVelocity == 0.0f)) continue;
+
 			blendedSteering.LinearVelocity += steering.LinearVelocity * weightedBehavior.second;
 			blendedSteering.AngularVelocity += steering.AngularVelocity * weightedBehavior.second;
 			totalWeight += weightedBehavior.second;
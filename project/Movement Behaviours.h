@@ -2,8 +2,9 @@
 #define STEERING_BEHAVIOURS
 
 #include "Exam_HelperStructs.h"
-
-class IExamInterface;
+#include "Random Generator.h"
+#include "Spatial Hash.h"
+#include "Path Smoother.h"
 
 namespace MovementBehavior
 {
@@ -13,10 +14,20 @@ namespace MovementBehavior
 		Elite::Vector2 velocity;
 	};
 
+	// What the behaviours that move use to turn the point they want to go to into one they can reach, handed to them when they are made
+	struct PathFunctions final
+	{
+		// Gets a point and returns the next point on the nav mesh on the way there
+		std::function<Elite::Vector2(const Elite::Vector2&)> pathfinding;
+		// Optional, gets the agent's own history, our position, the nav mesh point and the target and returns the point we actually steer to
+		std::function<Elite::Vector2(Navigation::SmoothingHistory&, const Elite::Vector2&, const Elite::Vector2&, const Elite::Vector2&)> smoothing;
+	};
+
 	class ISteeringBehavior
 	{
 	public:
 		ISteeringBehavior() = default;
+		ISteeringBehavior(const PathFunctions& pathFunctions);
 		virtual ~ISteeringBehavior() = default;
 
 		ISteeringBehavior(const ISteeringBehavior& other) = delete;
@@ -25,17 +36,21 @@ namespace MovementBehavior
 		ISteeringBehavior& operator=(ISteeringBehavior&& other) = delete;
 
 		virtual SteeringPlugin_Output CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData) = 0;
-		static void SetPathfindingFunction(IExamInterface* pInterface, std::function<Elite::Vector2(IExamInterface*, Elite::Vector2)> function);
 
 	protected:
-		static std::function<Elite::Vector2(Elite::Vector2)> m_PathfindingFunction;
-		static void OrientTo(float& angularVelocity, const AgentInfo& agentInfo, const Elite::Vector2& point);
+		// Empty for the behaviours that don't move themselves
+		const PathFunctions m_PathFunctions{};
+		// What the smoother remembers about our path, so no other behaviour or agent overwrites it
+		Navigation::SmoothingHistory m_SmoothingHistory{};
+
+		Elite::Vector2 GetPathPoint(const Elite::Vector2& position, const Elite::Vector2& target);
+		static void OrientTo(float& angularVelocity, float deltaT, const AgentInfo& agentInfo, const Elite::Vector2& point);
 	};
 
 	class Seek final : public ISteeringBehavior
 	{
 	public:
-		Seek() = default;
+		Seek(const PathFunctions& pathFunctions);
 		virtual ~Seek() = default;
 
 		Seek(const Seek& other) = delete;
@@ -49,7 +64,7 @@ namespace MovementBehavior
 	class Flee final : public ISteeringBehavior
 	{
 	public:
-		Flee() = default;
+		Flee(const PathFunctions& pathFunctions);
 		virtual ~Flee() = default;
 
 		Flee(const Flee& other) = delete;
@@ -63,7 +78,7 @@ namespace MovementBehavior
 	class Arrive final : public ISteeringBehavior
 	{
 	public:
-		Arrive(float slowRadius = 15.0f, float targetRadius = 3.0f);
+		Arrive(const PathFunctions& pathFunctions, float slowRadius = 15.0f, float targetRadius = 3.0f);
 		virtual ~Arrive() = default;
 
 		Arrive(const Arrive& other) = delete;
@@ -83,7 +98,7 @@ namespace MovementBehavior
 	class Pursuit final : public ISteeringBehavior
 	{
 	public:
-		Pursuit() = default;
+		Pursuit(const PathFunctions& pathFunctions);
 		virtual ~Pursuit() = default;
 
 		Pursuit(const Pursuit& other) = delete;
@@ -97,7 +112,7 @@ namespace MovementBehavior
 	class Evade final : public ISteeringBehavior
 	{
 	public:
-		Evade() = default;
+		Evade(const PathFunctions& pathFunctions);
 		virtual ~Evade() = default;
 
 		Evade(const Evade& other) = delete;
@@ -111,7 +126,7 @@ namespace MovementBehavior
 	class Wander final : public ISteeringBehavior
 	{
 	public:
-		Wander(float offset = 6.0f, float radius = 4.0f, float maxAngleChangeDegrees = Elite::ToRadians(70.0f));
+		Wander(const PathFunctions& pathFunctions, float offset = 6.0f, float radius = 4.0f, float maxAngleChangeDegrees = Elite::ToRadians(70.0f), uint32_t seed = 0);
 		virtual ~Wander() = default;
 
 		Wander(const Wander& other) = delete;
@@ -124,12 +139,71 @@ namespace MovementBehavior
 		void SetWanderRadius(float radius);
 		void SetMaxAngleChange(float radians);
 		void SetWanderAngle(float angle);
+		void SetSeed(uint32_t seed);
+		void GenerateAngleDeltas(float* pAngleDeltas, size_t count);
 
 	private:
 		float m_WanderOffset;
 		float m_WanderRadius;
 		float m_MaxAngleChange;
 		float m_WanderAngle;
+		RandomGenerator m_RandomGenerator;
+		// Angle changes are generated a block at a time instead of one random call per update
+		std::array<float, 64> m_AngleDeltas;
+		size_t m_NextAngleDelta;
+	};
+
+	class ContextSteering final : public ISteeringBehavior
+	{
+	public:
+		ContextSteering(const PathFunctions& pathFunctions, int slotCount = 32, float dangerRange = 10.0f, float dangerTolerance = 0.1f, float lookAheadDistance = 6.0f);
+		virtual ~ContextSteering() = default;
+
+		ContextSteering(const ContextSteering& other) = delete;
+		ContextSteering& operator=(const ContextSteering& other) = delete;
+		ContextSteering(ContextSteering&& other) = delete;
+		ContextSteering& operator=(ContextSteering&& other) = delete;
+
+		virtual SteeringPlugin_Output CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData) override;
+		void ClearMaps();
+		void AddInterest(const Elite::Vector2& agentPosition, const Elite::Vector2& point, float weight = 1.0f);
+		void AddDanger(const Elite::Vector2& agentPosition, const Elite::Vector2& point, float radius, float weight = 1.0f);
+		void AddDangerRectangle(const Elite::Vector2& agentPosition, const Elite::Vector2& center, const Elite::Vector2& size, float weight = 1.0f);
+
+	private:
+		// Slot directions are stored as separate x / y arrays so the per slot loops stay branchless and vectorizable
+		std::vector<float> m_SlotDirectionsX;
+		std::vector<float> m_SlotDirectionsY;
+		std::vector<float> m_Interest;
+		std::vector<float> m_Danger;
+		float m_DangerRange;
+		float m_DangerTolerance;
+		float m_LookAheadDistance;
+	};
+
+	class Separation final : public ISteeringBehavior
+	{
+	public:
+		Separation(float neighbourRadius = 5.0f, float wallRadius = 1.5f, float wallWeight = 0.5f);
+		virtual ~Separation() = default;
+
+		Separation(const Separation& other) = delete;
+		Separation& operator=(const Separation& other) = delete;
+		Separation(Separation&& other) = delete;
+		Separation& operator=(Separation&& other) = delete;
+
+		virtual SteeringPlugin_Output CalculateSteering(float deltaT, const AgentInfo& agentInfo, const TargetData& targetData) override;
+		void ClearNeighbours();
+		void AddNeighbour(const Elite::Vector2& position, float radius);
+		void AddHouseWalls(const Elite::Vector2& center, const Elite::Vector2& size);
+
+	private:
+		// Neighbours are refilled every frame, walls are only added when we discover a house
+		SpatialHash m_Neighbours;
+		SpatialHash m_Walls;
+		float m_NeighbourRadius;
+		float m_WallRadius;
+		float m_WallWeight;
 	};
 
 	class BlendedSteering final : public ISteeringBehavior
@@ -0,0 +1,227 @@
+#include "stdafx.h"
+#include "Navigation Grid.h"
+
+namespace Navigation
+{
+	NavigationGrid::NavigationGrid(const WorldInfo& worldInfo, float cellSize, float wallCost) :
+		m_Origin{ worldInfo.Center - (worldInfo.Dimensions / 2.0f) },
+		m_CellSize{ cellSize },
+		m_WallCost{ wallCost },
+		m_Columns{ std::max(int(ceilf(worldInfo.Dimensions.x / cellSize)), 1) },
+		m_Rows{ std::max(int(ceilf(worldInfo.Dimensions.y / cellSize)), 1) },
+		m_WallCosts(size_t(m_Columns * m_Rows), 0.0f),
+		m_Dangers(size_t(m_Columns * m_Rows), 0.0f),
+		m_ZoneDangers(size_t(m_Columns * m_Rows), 0.0f),
+		m_PendingZoneDangers(size_t(m_Columns * m_Rows), 0.0f),
+		m_Costs(size_t(m_Columns * m_Rows), 1.0f),
+		m_ChangedCells{},
+		m_Version{ 0 }
+	{
+
+	}
+
+	int NavigationGrid::GetColumns() const
+	{
+		return m_Columns;
+	}
+
+	int NavigationGrid::GetRows() const
+	{
+		return m_Rows;
+	}
+
+	int NavigationGrid::GetCellCount() const
+	{
+		return m_Columns * m_Rows;
+	}
+
+	float NavigationGrid::GetCellSize() const
+	{
+		return m_CellSize;
+	}
+
+	int NavigationGrid::GetCellIndex(const Elite::Vector2& position) const
+	{
+		// Positions outside the world are moved to the closest border cell
+		const int column{ std::clamp(int(floorf((position.x - m_Origin.x) / m_CellSize)), 0, m_Columns - 1) };
+		const int row{ std::clamp(int(floorf((position.y - m_Origin.y) / m_CellSize)), 0, m_Rows - 1) };
+
+		return (row * m_Columns) + column;
+	}
+
+	int NavigationGrid::GetCellIndex(int column, int row) const
+	{
+		if ((column < 0) || (column >= m_Columns) || (row < 0) || (row >= m_Rows)) return -1;
+
+		return (row * m_Columns) + column;
+	}
+
+	int NavigationGrid::GetColumn(int cell) const
+	{
+		return cell % m_Columns;
+	}
+
+	int NavigationGrid::GetRow(int cell) const
+	{
+		return cell / m_Columns;
+	}
+
+	Elite::Vector2 NavigationGrid::GetCellCenter(int cell) const
+	{
+		return Elite::Vector2
+		{
+			m_Origin.x + ((float(GetColumn(cell)) + 0.5f) * m_CellSize),
+			m_Origin.y + ((float(GetRow(cell)) + 0.5f) * m_CellSize)
+		};
+	}
+
+	float NavigationGrid::GetCost(int cell) const
+	{
+		return m_Costs[cell];
+	}
+
+	float NavigationGrid::GetDanger(int cell) const
+	{
+		return std::max(m_Dangers[cell], m_ZoneDangers[cell]);
+	}
+
+	float NavigationGrid::GetMoveCost(int fromCell, int toCell) const
+	{
+		// Diagonal steps are longer, the cost is the average of both cells we pass through
+		const bool diagonal{ (GetColumn(fromCell) != GetColumn(toCell)) && (GetRow(fromCell) != GetRow(toCell)) };
+		const float distance{ diagonal ? (m_CellSize * 1.41421356f) : m_CellSize };
+
+		return distance * ((m_Costs[fromCell] + m_Costs[toCell]) * 0.5f);
+	}
+
+	float NavigationGrid::GetHeuristic(int fromCell, int toCell) const
+	{
+		// Octile distance, every cell costs at least 1 so this never overestimates
+		const float columns{ float(std::abs(GetColumn(fromCell) - GetColumn(toCell))) };
+		const float rows{ float(std::abs(GetRow(fromCell) - GetRow(toCell))) };
+
+		return m_CellSize * (std::max(columns, rows) + (0.41421356f * std::min(columns, rows)));
+	}
+
+	void NavigationGrid::AddHouse(const Elite::Vector2& center, const Elite::Vector2& size)
+	{
+		// Only the walls are expensive, we don't know where the door is so they can't be fully blocked
+		const Elite::Vector2 halfSize{ size / 2.0f };
+		const int minimumColumn{ GetColumn(GetCellIndex(center - halfSize)) };
+		const int maximumColumn{ GetColumn(GetCellIndex(center + halfSize)) };
+		const int minimumRow{ GetRow(GetCellIndex(center - halfSize)) };
+		const int maximumRow{ GetRow(GetCellIndex(center + halfSize)) };
+
+		for (int row{ minimumRow }; row <= maximumRow; ++row)
+		{
+			for (int column{ minimumColumn }; column <= maximumColumn; ++column)
+			{
+				const bool wall{ (row == minimumRow) || (row == maximumRow) || (column == minimumColumn) || (column == maximumColumn) };
+				const int cell{ GetCellIndex(column, row) };
+
+				if (wall && (m_WallCosts[cell] < m_WallCost))
+				{
+					m_WallCosts[cell] = m_WallCost;
+					RefreshCost(cell);
+				}
+			}
+		}
+	}
+
+	void NavigationGrid::AddDanger(const Elite::Vector2& position, float danger)
+	{
+		// The cell itself gets the full danger, its neighbours half of it
+		const int cell{ GetCellIndex(position) };
+		if (m_Dangers[cell] < danger)
+		{
+			m_Dangers[cell] = danger;
+			RefreshCost(cell);
+		}
+
+		ForEachNeighbour(cell, [this, danger](int neighbour) -> void
+			{
+				if (m_Dangers[neighbour] < (danger * 0.5f))
+				{
+					m_Dangers[neighbour] = danger * 0.5f;
+					RefreshCost(neighbour);
+				}
+			});
+	}
+
+	void NavigationGrid::DecayDanger(float deltaTime, float halfLife)
+	{
+		const float decay{ powf(0.5f, deltaTime / halfLife) };
+		const int cellCount{ GetCellCount() };
+
+		for (int cell{}; cell < cellCount; ++cell)
+		{
+			if (m_Dangers[cell] <= 0.0f) continue;
+
+			m_Dangers[cell] *= decay;
+			if (m_Dangers[cell] < 0.05f) m_Dangers[cell] = 0.0f;
+			RefreshCost(cell);
+		}
+	}
+
+	void NavigationGrid::ClearZoneDanger()
+	{
+		std::ranges::fill(m_PendingZoneDangers, 0.0f);
+	}
+
+	void NavigationGrid::AddZoneDanger(const Elite::Vector2& center, float radius, float danger)
+	{
+		const Elite::Vector2 extent{ radius, radius };
+		const int minimumColumn{ GetColumn(GetCellIndex(center - extent)) };
+		const int maximumColumn{ GetColumn(GetCellIndex(center + extent)) };
+		const int minimumRow{ GetRow(GetCellIndex(center - extent)) };
+		const int maximumRow{ GetRow(GetCellIndex(center + extent)) };
+
+		for (int row{ minimumRow }; row <= maximumRow; ++row)
+		{
+			for (int column{ minimumColumn }; column <= maximumColumn; ++column)
+			{
+				const int cell{ GetCellIndex(column, row) };
+				if (GetCellCenter(cell).DistanceSquared(center) < (radius * radius)) m_PendingZoneDangers[cell] = std::max(m_PendingZoneDangers[cell], danger);
+			}
+		}
+	}
+
+	void NavigationGrid::ApplyZoneDanger()
+	{
+		const int cellCount{ GetCellCount() };
+		for (int cell{}; cell < cellCount; ++cell)
+		{
+			if (m_PendingZoneDangers[cell] == m_ZoneDangers[cell]) continue;
+
+			m_ZoneDangers[cell] = m_PendingZoneDangers[cell];
+			RefreshCost(cell);
+		}
+	}
+
+	const std::vector<int>& NavigationGrid::GetChangedCells() const
+	{
+		return m_ChangedCells;
+	}
+
+	void NavigationGrid::ClearChangedCells()
+	{
+		m_ChangedCells.clear();
+	}
+
+	unsigned int NavigationGrid::GetVersion() const
+	{
+		return m_Version;
+	}
+
+	void NavigationGrid::RefreshCost(int cell)
+	{
+		// Costs are rounded so slowly decaying danger doesn't invalidate our paths every single frame
+		const float cost{ roundf(1.0f + m_WallCosts[cell] + GetDanger(cell)) };
+		if (cost != m_Costs[cell])
+		{
+			m_Costs[cell] = cost;
+			m_ChangedCells.push_back(cell);
+			++m_Version;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef NAVIGATION_GRID
+#define NAVIGATION_GRID
+
+#include "Exam_HelperStructs.h"
+#include <vector>
+
+namespace Navigation
+{
+	// Coarse grid over the whole world with a travel cost per cell, house walls and danger make cells more expensive
+	class NavigationGrid final
+	{
+	public:
+		NavigationGrid(const WorldInfo& worldInfo, float cellSize = 4.0f, float wallCost = 8.0f);
+		~NavigationGrid() = default;
+
+		NavigationGrid(const NavigationGrid&) = delete;
+		NavigationGrid& operator=(const NavigationGrid&) = delete;
+		NavigationGrid(NavigationGrid&&) = delete;
+		NavigationGrid& operator=(NavigationGrid&&) = delete;
+
+		int GetColumns() const;
+		int GetRows() const;
+		int GetCellCount() const;
+		float GetCellSize() const;
+		int GetCellIndex(const Elite::Vector2& position) const;
+		int GetCellIndex(int column, int row) const;
+		int GetColumn(int cell) const;
+		int GetRow(int cell) const;
+		Elite::Vector2 GetCellCenter(int cell) const;
+
+		float GetCost(int cell) const;
+		float GetDanger(int cell) const;
+		float GetMoveCost(int fromCell, int toCell) const;
+		float GetHeuristic(int fromCell, int toCell) const;
+
+		void AddHouse(const Elite::Vector2& center, const Elite::Vector2& size);
+		void AddDanger(const Elite::Vector2& position, float danger);
+		void DecayDanger(float deltaTime, float halfLife = 5.0f);
+
+		// Purge zones are kept apart and don't decay, they are rebuilt only when the zones change
+		// Clear, add every zone (cells with their center inside the circle), then apply, only cells that end up different get touched
+		void ClearZoneDanger();
+		void AddZoneDanger(const Elite::Vector2& center, float radius, float danger);
+		void ApplyZoneDanger();
+
+		// Every cell whose cost changed since the last clear, used to repair paths
+		const std::vector<int>& GetChangedCells() const;
+		void ClearChangedCells();
+		unsigned int GetVersion() const;
+
+		// Calls function(int neighbour) for all 8 neighbours that are inside the grid
+		template<typename Function>
+		void ForEachNeighbour(int cell, Function function) const
+		{
+			const int column{ GetColumn(cell) };
+			const int row{ GetRow(cell) };
+
+			for (int rowOffset{ -1 }; rowOffset <= 1; ++rowOffset)
+			{
+				for (int columnOffset{ -1 }; columnOffset <= 1; ++columnOffset)
+				{
+					if ((rowOffset == 0) && (columnOffset == 0)) continue;
+
+					const int neighbour{ GetCellIndex(column + columnOffset, row + rowOffset) };
+					if (neighbour != -1) function(neighbour);
+				}
+			}
+		}
+
+	private:
+		Elite::Vector2 m_Origin;
+		float m_CellSize;
+		float m_WallCost;
+		int m_Columns;
+		int m_Rows;
+		std::vector<float> m_WallCosts;
+		std::vector<float> m_Dangers;
+		std::vector<float> m_ZoneDangers;
+		std::vector<float> m_PendingZoneDangers;
+		std::vector<float> m_Costs;
+		std::vector<int> m_ChangedCells;
+		unsigned int m_Version;
+
+		void RefreshCost(int cell);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,353 @@
+#include "stdafx.h"
+#include "Path Planner.h"
+#include "Navigation Grid.h"
+
+namespace Navigation
+{
+#pragma region AStar
+	AStar::AStar(const NavigationGrid* pGrid, size_t cacheSize) :
+		m_pGrid{ pGrid },
+		m_CacheSize{ cacheSize },
+		m_Cache{},
+		m_Costs(size_t(pGrid->GetCellCount()), 0.0f),
+		m_Parents(size_t(pGrid->GetCellCount()), -1),
+		m_OpenedIds(size_t(pGrid->GetCellCount()), 0),
+		m_ClosedIds(size_t(pGrid->GetCellCount()), 0),
+		m_ChangedIds(size_t(pGrid->GetCellCount()), 0),
+		m_SearchId{ 0 },
+		m_InvalidateId{ 0 },
+		m_SearchVersion{ 0 },
+		m_Open{},
+		m_StartCell{ -1 },
+		m_GoalCell{ -1 },
+		m_Goal{},
+		m_Status{ PathStatus::Idle },
+		m_Path{}
+	{
+
+	}
+
+	void AStar::Begin(const Elite::Vector2& start, const Elite::Vector2& goal)
+	{
+		m_StartCell = m_pGrid->GetCellIndex(start);
+		m_GoalCell = m_pGrid->GetCellIndex(goal);
+		m_Goal = goal;
+		m_Path.clear();
+		m_Open.clear();
+
+		// Reuse the path if none of its cells changed since we last went between these cells
+		auto itCachedPath{ m_Cache.find(GetCacheKey()) };
+		if (itCachedPath != std::end(m_Cache))
+		{
+			m_Path = itCachedPath->second.path;
+			m_Path.back() = m_Goal;
+			m_Status = PathStatus::Found;
+			return;
+		}
+
+		// A search can be spread over several frames, a path is only as recent as the grid it started on
+		++m_SearchId;
+		m_SearchVersion = m_pGrid->GetVersion();
+		m_Costs[m_StartCell] = 0.0f;
+		m_Parents[m_StartCell] = -1;
+		m_OpenedIds[m_StartCell] = m_SearchId;
+		m_Open.push_back(OpenNode{ m_pGrid->GetHeuristic(m_StartCell, m_GoalCell), m_StartCell });
+		m_Status = PathStatus::Searching;
+	}
+
+	PathStatus AStar::Step(int maximumExpansions)
+	{
+		for (int expansion{}; (expansion < maximumExpansions) && (m_Status == PathStatus::Searching); ++expansion)
+		{
+			if (m_Open.empty())
+			{
+				m_Status = PathStatus::Failed;
+				break;
+			}
+
+			std::pop_heap(std::begin(m_Open), std::end(m_Open), std::greater<OpenNode>{});
+			const int cell{ m_Open.back().cell };
+			m_Open.pop_back();
+
+			// The same cell can be in the open list more than once, only the cheapest one counts
+			if (m_ClosedIds[cell] == m_SearchId) continue;
+			m_ClosedIds[cell] = m_SearchId;
+
+			if (cell == m_GoalCell)
+			{
+				BuildPath();
+				m_Status = PathStatus::Found;
+				break;
+			}
+
+			m_pGrid->ForEachNeighbour(cell, [this, cell](int neighbour) -> void
+				{
+					if (m_ClosedIds[neighbour] == m_SearchId) return;
+
+					const float cost{ m_Costs[cell] + m_pGrid->GetMoveCost(cell, neighbour) };
+					if ((m_OpenedIds[neighbour] != m_SearchId) || (cost < m_Costs[neighbour]))
+					{
+						m_OpenedIds[neighbour] = m_SearchId;
+						m_Costs[neighbour] = cost;
+						m_Parents[neighbour] = cell;
+						m_Open.push_back(OpenNode{ cost + m_pGrid->GetHeuristic(neighbour, m_GoalCell), neighbour });
+						std::push_heap(std::begin(m_Open), std::end(m_Open), std::greater<OpenNode>{});
+					}
+				});
+		}
+
+		return m_Status;
+	}
+
+	PathStatus AStar::GetStatus() const
+	{
+		return m_Status;
+	}
+
+	const std::vector<Elite::Vector2>& AStar::GetPath() const
+	{
+		return m_Path;
+	}
+
+	bool AStar::FindPath(const Elite::Vector2& start, const Elite::Vector2& goal, std::vector<Elite::Vector2>& path)
+	{
+		Begin(start, goal);
+		Step(INT_MAX);
+
+		path = m_Path;
+		return m_Status == PathStatus::Found;
+	}
+
+	void AStar::Invalidate(const std::vector<int>& changedCells)
+	{
+		if (changedCells.empty() || m_Cache.empty()) return;
+
+		// Mark the changed cells once, then every cached path only has to look at its own cells
+		++m_InvalidateId;
+		std::ranges::for_each(changedCells, [this](int cell) -> void { m_ChangedIds[cell] = m_InvalidateId; });
+		std::erase_if(m_Cache, [this](const auto& cachedPath) -> bool
+			{
+				return std::ranges::any_of(cachedPath.second.cells, [this](int cell) -> bool { return m_ChangedIds[cell] == m_InvalidateId; });
+			});
+	}
+
+	unsigned long long AStar::GetCacheKey() const
+	{
+		return (static_cast<unsigned long long>(uint32_t(m_StartCell)) << 32) | uint32_t(m_GoalCell);
+	}
+
+	void AStar::BuildPath()
+	{
+		// Walk back from the goal, the start cell is where we are now so it is left out of the path
+		std::vector<int> cells{ m_StartCell };
+		for (int cell{ m_GoalCell }; cell != m_StartCell; cell = m_Parents[cell])
+		{
+			m_Path.push_back(m_pGrid->GetCellCenter(cell));
+			cells.push_back(cell);
+		}
+		std::reverse(std::begin(m_Path), std::end(m_Path));
+		if (m_Path.empty()) m_Path.push_back(m_Goal);
+
+		// A search spread over frames may have missed changes it already walked past, only remember paths the grid held still for
+		if (m_SearchVersion == m_pGrid->GetVersion())
+		{
+			// Keep the cache small, old paths are probably outdated anyway
+			if (m_Cache.size() >= m_CacheSize) m_Cache.clear();
+			m_Cache[GetCacheKey()] = CachedPath{ std::move(cells), m_Path };
+		}
+
+		m_Path.back() = m_Goal;
+	}
+#pragma endregion
+
+#pragma region DStarLite
+	DStarLite::DStarLite(const NavigationGrid* pGrid) :
+		m_pGrid{ pGrid },
+		m_Costs(size_t(pGrid->GetCellCount()), FLT_MAX),
+		m_LookAheadCosts(size_t(pGrid->GetCellCount()), FLT_MAX),
+		m_OpenKeys(size_t(pGrid->GetCellCount()), Key{}),
+		m_InOpen(size_t(pGrid->GetCellCount()), false),
+		m_Open{},
+		m_KeyModifier{ 0.0f },
+		m_StartCell{ -1 },
+		m_LastStartCell{ -1 },
+		m_GoalCell{ -1 },
+		m_Goal{},
+		m_Initialized{ false }
+	{
+
+	}
+
+	void DStarLite::Initialize(const Elite::Vector2& start, const Elite::Vector2& goal)
+	{
+		std::fill(std::begin(m_Costs), std::end(m_Costs), FLT_MAX);
+		std::fill(std::begin(m_LookAheadCosts), std::end(m_LookAheadCosts), FLT_MAX);
+		std::fill(std::begin(m_InOpen), std::end(m_InOpen), false);
+		m_Open.clear();
+
+		// We search backwards from the goal, so the start can move without throwing the search away
+		m_KeyModifier = 0.0f;
+		m_StartCell = m_pGrid->GetCellIndex(start);
+		m_LastStartCell = m_StartCell;
+		m_GoalCell = m_pGrid->GetCellIndex(goal);
+		m_Goal = goal;
+		m_LookAheadCosts[m_GoalCell] = 0.0f;
+		Push(m_GoalCell);
+		m_Initialized = true;
+	}
+
+	void DStarLite::UpdateStart(const Elite::Vector2& start)
+	{
+		m_StartCell = m_pGrid->GetCellIndex(start);
+	}
+
+	void DStarLite::Repair(const std::vector<int>& changedCells)
+	{
+		if (!m_Initialized || changedCells.empty()) return;
+
+		// Keys already in the open list are based on the old start, adding the distance we moved keeps them comparable
+		m_KeyModifier += m_pGrid->GetHeuristic(m_LastStartCell, m_StartCell);
+		m_LastStartCell = m_StartCell;
+
+		// A changed cell changes the edges to all its neighbours
+		for (int cell : changedCells)
+		{
+			UpdateCell(cell);
+			m_pGrid->ForEachNeighbour(cell, [this](int neighbour) -> void { UpdateCell(neighbour); });
+		}
+	}
+
+	bool DStarLite::ComputeShortestPath(int maximumExpansions)
+	{
+		if (!m_Initialized) return false;
+
+		for (int expansion{}; expansion < maximumExpansions; ++expansion)
+		{
+			// Throw away entries that were replaced by a newer key
+			while (!m_Open.empty() && (!m_InOpen[m_Open.front().cell] || !(m_Open.front().key == m_OpenKeys[m_Open.front().cell])))
+			{
+				std::pop_heap(std::begin(m_Open), std::end(m_Open), std::greater<OpenNode>{});
+				m_Open.pop_back();
+			}
+
+			const bool startConsistent{ m_Costs[m_StartCell] == m_LookAheadCosts[m_StartCell] };
+			if (m_Open.empty() || (!(m_Open.front().key < CalculateKey(m_StartCell)) && startConsistent)) return true;
+
+			std::pop_heap(std::begin(m_Open), std::end(m_Open), std::greater<OpenNode>{});
+			const OpenNode node{ m_Open.back() };
+			m_Open.pop_back();
+			m_InOpen[node.cell] = false;
+
+			const Key newKey{ CalculateKey(node.cell) };
+			if (node.key < newKey)
+			{
+				Push(node.cell);
+			}
+			else if (m_Costs[node.cell] > m_LookAheadCosts[node.cell])
+			{
+				m_Costs[node.cell] = m_LookAheadCosts[node.cell];
+				m_pGrid->ForEachNeighbour(node.cell, [this](int neighbour) -> void { UpdateCell(neighbour); });
+			}
+			else
+			{
+				m_Costs[node.cell] = FLT_MAX;
+				UpdateCell(node.cell);
+				m_pGrid->ForEachNeighbour(node.cell, [this](int neighbour) -> void { UpdateCell(neighbour); });
+			}
+		}
+
+		return false;
+	}
+
+	bool DStarLite::GetPath(std::vector<Elite::Vector2>& path, size_t maximumLength) const
+	{
+		path.clear();
+		if (!m_Initialized || (m_Costs[m_StartCell] == FLT_MAX)) return false;
+
+		// Follow the cheapest neighbour from the start until we reach the goal
+		int cell{ m_StartCell };
+		while ((cell != m_GoalCell) && (path.size() < maximumLength))
+		{
+			int nextCell{ -1 };
+			float nextCost{ FLT_MAX };
+			m_pGrid->ForEachNeighbour(cell, [this, cell, &nextCell, &nextCost](int neighbour) -> void
+				{
+					if (m_Costs[neighbour] == FLT_MAX) return;
+
+					const float cost{ m_pGrid->GetMoveCost(cell, neighbour) + m_Costs[neighbour] };
+					if (cost < nextCost)
+					{
+						nextCost = cost;
+						nextCell = neighbour;
+					}
+				});
+
+			if (nextCell == -1) return false;
+
+			cell = nextCell;
+			path.push_back(m_pGrid->GetCellCenter(cell));
+		}
+
+		if (path.empty()) path.push_back(m_Goal);
+		else if (cell == m_GoalCell) path.back() = m_Goal;
+
+		return true;
+	}
+
+	bool DStarLite::IsInitialized() const
+	{
+		return m_Initialized;
+	}
+
+	const Elite::Vector2& DStarLite::GetGoal() const
+	{
+		return m_Goal;
+	}
+
+	DStarLite::Key DStarLite::CalculateKey(int cell) const
+	{
+		const float cost{ std::min(m_Costs[cell], m_LookAheadCosts[cell]) };
+		if (cost == FLT_MAX) return Key{ FLT_MAX, FLT_MAX };
+
+		return Key{ cost + m_pGrid->GetHeuristic(m_StartCell, cell) + m_KeyModifier, cost };
+	}
+
+	void DStarLite::UpdateCell(int cell)
+	{
+		// The look ahead cost is the cheapest way to the goal through one of our neighbours
+		if (cell != m_GoalCell)
+		{
+			float lookAheadCost{ FLT_MAX };
+			m_pGrid->ForEachNeighbour(cell, [this, cell, &lookAheadCost](int neighbour) -> void
+				{
+					if (m_Costs[neighbour] == FLT_MAX) return;
+					lookAheadCost = std::min(lookAheadCost, m_pGrid->GetMoveCost(cell, neighbour) + m_Costs[neighbour]);
+				});
+			m_LookAheadCosts[cell] = lookAheadCost;
+		}
+
+		if (m_Costs[cell] != m_LookAheadCosts[cell]) Push(cell);
+		else m_InOpen[cell] = false;
+	}
+
+	void DStarLite::Push(int cell)
+	{
+		m_OpenKeys[cell] = CalculateKey(cell);
+		m_InOpen[cell] = true;
+		m_Open.push_back(OpenNode{ m_OpenKeys[cell], cell });
+		std::push_heap(std::begin(m_Open), std::end(m_Open), std::greater<OpenNode>{});
+	}
+#pragma endregion
+
+	Elite::Vector2 GetLookAheadPoint(const std::vector<Elite::Vector2>& path, const Elite::Vector2& position, size_t lookAhead)
+	{
+		auto itClosest{ std::ranges::min_element(path, [&position](const Elite::Vector2& point1, const Elite::Vector2& point2) -> bool
+				{
+					return position.DistanceSquared(point1) < position.DistanceSquared(point2);
+				}
+		) };
+
+		const size_t index{ size_t(std::distance(std::begin(path), itClosest)) + lookAhead };
+		return path.at(std::min(index, path.size() - 1));
+	}
+}
\ No newline at end of file
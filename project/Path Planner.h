@@ -0,0 +1,140 @@
+#ifndef PATH_PLANNER
+#define PATH_PLANNER
+
+#include <vector>
+#include <unordered_map>
+#include <climits>
+
+namespace Navigation
+{
+	class NavigationGrid;
+
+	enum class PathStatus
+	{
+		Idle,
+		Searching,
+		Found,
+		Failed
+	};
+
+	// A* over the navigation grid, can run in steps and remembers paths until a cell along them changes
+	class AStar final
+	{
+	public:
+		explicit AStar(const NavigationGrid* pGrid, size_t cacheSize = 32);
+		~AStar() = default;
+
+		AStar(const AStar&) = delete;
+		AStar& operator=(const AStar&) = delete;
+		AStar(AStar&&) = delete;
+		AStar& operator=(AStar&&) = delete;
+
+		void Begin(const Elite::Vector2& start, const Elite::Vector2& goal);
+		PathStatus Step(int maximumExpansions);
+		PathStatus GetStatus() const;
+		const std::vector<Elite::Vector2>& GetPath() const;
+		bool FindPath(const Elite::Vector2& start, const Elite::Vector2& goal, std::vector<Elite::Vector2>& path);
+		// Forgets the remembered paths that go through one of these cells, has to see every change the grid makes before they are cleared
+		void Invalidate(const std::vector<int>& changedCells);
+
+	private:
+		struct OpenNode final
+		{
+			float totalCost;
+			int cell;
+
+			bool operator>(const OpenNode& other) const { return totalCost > other.totalCost; }
+		};
+
+		struct CachedPath final
+		{
+			std::vector<int> cells;
+			std::vector<Elite::Vector2> path;
+		};
+
+		const NavigationGrid* m_pGrid;
+		size_t m_CacheSize;
+		std::unordered_map<unsigned long long, CachedPath> m_Cache;
+
+		// Per cell search data, the search ids let us reuse the arrays without clearing them for every search
+		std::vector<float> m_Costs;
+		std::vector<int> m_Parents;
+		std::vector<unsigned int> m_OpenedIds;
+		std::vector<unsigned int> m_ClosedIds;
+		std::vector<unsigned int> m_ChangedIds;
+		unsigned int m_SearchId;
+		unsigned int m_InvalidateId;
+		unsigned int m_SearchVersion;
+		std::vector<OpenNode> m_Open;
+
+		int m_StartCell;
+		int m_GoalCell;
+		Elite::Vector2 m_Goal;
+		PathStatus m_Status;
+		std::vector<Elite::Vector2> m_Path;
+
+		unsigned long long GetCacheKey() const;
+		void BuildPath();
+	};
+
+	// D* Lite keeps the search tree of one route alive so it only repairs the part that changed when the grid changes
+	class DStarLite final
+	{
+	public:
+		explicit DStarLite(const NavigationGrid* pGrid);
+		~DStarLite() = default;
+
+		DStarLite(const DStarLite&) = delete;
+		DStarLite& operator=(const DStarLite&) = delete;
+		DStarLite(DStarLite&&) = delete;
+		DStarLite& operator=(DStarLite&&) = delete;
+
+		void Initialize(const Elite::Vector2& start, const Elite::Vector2& goal);
+		void UpdateStart(const Elite::Vector2& start);
+		void Repair(const std::vector<int>& changedCells);
+		bool ComputeShortestPath(int maximumExpansions = INT_MAX);
+		bool GetPath(std::vector<Elite::Vector2>& path, size_t maximumLength = 256) const;
+		bool IsInitialized() const;
+		const Elite::Vector2& GetGoal() const;
+
+	private:
+		struct Key final
+		{
+			float first;
+			float second;
+
+			bool operator<(const Key& other) const { return (first < other.first) || ((first == other.first) && (second < other.second)); }
+			bool operator==(const Key& other) const { return (first == other.first) && (second == other.second); }
+		};
+
+		struct OpenNode final
+		{
+			Key key;
+			int cell;
+
+			bool operator>(const OpenNode& other) const { return other.key < key; }
+		};
+
+		const NavigationGrid* m_pGrid;
+		std::vector<float> m_Costs;
+		std::vector<float> m_LookAheadCosts;
+		std::vector<Key> m_OpenKeys;
+		std::vector<bool> m_InOpen;
+		std::vector<OpenNode> m_Open;
+		float m_KeyModifier;
+		int m_StartCell;
+		int m_LastStartCell;
+		int m_GoalCell;
+		Elite::Vector2 m_Goal;
+		bool m_Initialized;
+
+		Key CalculateKey(int cell) const;
+		void UpdateCell(int cell);
+		void Push(int cell);
+	};
+
+	// The point lookAhead waypoints past the waypoint closest to our position, or the end of the path
+	Elite::Vector2 GetLookAheadPoint(const std::vector<Elite::Vector2>& path, const Elite::Vector2& position, size_t lookAhead);
+}
+
+#endif
\ No newline at end of file
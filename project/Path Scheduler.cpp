@@ -0,0 +1,85 @@
+#include "stdafx.h"
+#include "Path Scheduler.h"
+#include <chrono>
+
+namespace Navigation
+{
+	PathScheduler::PathScheduler(const NavigationGrid* pGrid, int expansionsPerSlice) :
+		m_AStar{ pGrid },
+		m_ExpansionsPerSlice{ expansionsPerSlice },
+		m_NextId{ 1 },
+		m_Requests{},
+		m_CurrentId{ 0 },
+		m_Results{}
+	{
+
+	}
+
+	unsigned int PathScheduler::Request(const Elite::Vector2& start, const Elite::Vector2& goal)
+	{
+		const unsigned int id{ m_NextId++ };
+		if (m_NextId == 0) m_NextId = 1;
+
+		m_Requests.push_back(PathRequest{ id, start, goal });
+		return id;
+	}
+
+	void PathScheduler::Cancel(unsigned int id)
+	{
+		if (id == m_CurrentId) m_CurrentId = 0;
+
+		m_Results.erase(id);
+		std::erase_if(m_Requests, [id](const PathRequest& request) -> bool { return request.id == id; });
+	}
+
+	PathStatus PathScheduler::Poll(unsigned int id, std::vector<Elite::Vector2>& path)
+	{
+		auto itResult{ m_Results.find(id) };
+		if (itResult != std::end(m_Results))
+		{
+			const PathStatus status{ itResult->second.status };
+			path = std::move(itResult->second.path);
+			m_Results.erase(itResult);
+			return status;
+		}
+
+		const bool pending{ (id == m_CurrentId) || std::ranges::any_of(m_Requests, [id](const PathRequest& request) -> bool { return request.id == id; }) };
+		return pending ? PathStatus::Searching : PathStatus::Idle;
+	}
+
+	void PathScheduler::Update(long long budget)
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+
+		while ((m_CurrentId != 0) || !m_Requests.empty())
+		{
+			// Start on the oldest request, cached paths are done right away
+			if (m_CurrentId == 0)
+			{
+				const PathRequest request{ m_Requests.front() };
+				m_Requests.pop_front();
+				m_CurrentId = request.id;
+				m_AStar.Begin(request.start, request.goal);
+			}
+
+			const PathStatus status{ m_AStar.Step(m_ExpansionsPerSlice) };
+			if (status != PathStatus::Searching)
+			{
+				m_Results[m_CurrentId] = PathResult{ status, m_AStar.GetPath() };
+				m_CurrentId = 0;
+			}
+
+			if (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() >= budget) break;
+		}
+	}
+
+	void PathScheduler::Invalidate(const std::vector<int>& changedCells)
+	{
+		m_AStar.Invalidate(changedCells);
+	}
+
+	size_t PathScheduler::GetPendingCount() const
+	{
+		return m_Requests.size() + ((m_CurrentId != 0) ? 1 : 0);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef PATH_SCHEDULER
+#define PATH_SCHEDULER
+
+#include "Path Planner.h"
+#include <deque>
+#include <unordered_map>
+
+namespace Navigation
+{
+	// Queue of path requests that are worked on in small slices every frame, results are picked up later with the request id
+	class PathScheduler final
+	{
+	public:
+		explicit PathScheduler(const NavigationGrid* pGrid, int expansionsPerSlice = 64);
+		~PathScheduler() = default;
+
+		PathScheduler(const PathScheduler&) = delete;
+		PathScheduler& operator=(const PathScheduler&) = delete;
+		PathScheduler(PathScheduler&&) = delete;
+		PathScheduler& operator=(PathScheduler&&) = delete;
+
+		// Returns the id to poll the result with, never 0
+		unsigned int Request(const Elite::Vector2& start, const Elite::Vector2& goal);
+		void Cancel(unsigned int id);
+
+		// Searching while the request is waiting or being worked on, Found or Failed once (the result is handed over), Idle for unknown ids
+		PathStatus Poll(unsigned int id, std::vector<Elite::Vector2>& path);
+
+		// Works on the requests until the budget in microseconds is used up
+		void Update(long long budget);
+		// The cells the grid changed this frame, remembered paths through them are searched again
+		void Invalidate(const std::vector<int>& changedCells);
+
+		size_t GetPendingCount() const;
+
+	private:
+		struct PathRequest final
+		{
+			unsigned int id;
+			Elite::Vector2 start;
+			Elite::Vector2 goal;
+		};
+
+		struct PathResult final
+		{
+			PathStatus status;
+			std::vector<Elite::Vector2> path;
+		};
+
+		AStar m_AStar;
+		int m_ExpansionsPerSlice;
+		unsigned int m_NextId;
+		std::deque<PathRequest> m_Requests;
+		unsigned int m_CurrentId;
+		std::unordered_map<unsigned int, PathResult> m_Results;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "stdafx.h"
+#include "Path Smoother.h"
+
+namespace Navigation
+{
+	PathSmoother::PathSmoother(float agentRadius, float lookAhead) :
+		m_AgentRadius{ agentRadius },
+		m_LookAhead{ lookAhead },
+		m_Obstacles{}
+	{
+
+	}
+
+	void PathSmoother::AddObstacle(const Elite::Vector2& center, const Elite::Vector2& size)
+	{
+		if (std::ranges::any_of(m_Obstacles, [&center](const Obstacle& obstacle) -> bool { return obstacle.center.DistanceSquared(center) < 0.25f; })) return;
+
+		// Grow the house by our radius so a clear line also means our body fits past the corner
+		const Elite::Vector2 halfSize{ (size / 2.0f) + Elite::Vector2{ m_AgentRadius, m_AgentRadius } };
+		m_Obstacles.push_back(Obstacle{ center, center - halfSize, center + halfSize });
+	}
+
+	Elite::Vector2 PathSmoother::Smooth(SmoothingHistory& history, const Elite::Vector2& position, const Elite::Vector2& pathPoint, const Elite::Vector2& target) const
+	{
+		// A new target means a new path, the old points mean nothing anymore
+		if (history.target.DistanceSquared(target) > 1.0f)
+		{
+			history.size = 0;
+			history.target = target;
+		}
+		AddToHistory(history, pathPoint);
+
+		// Line of sight ignores the house we are in or going into, only the nav mesh knows where its door is
+		if (IsInsideObstacle(position) || IsInsideObstacle(target)) return pathPoint;
+
+		// The nav mesh flipping between two corners (A, B, A) makes us zig-zag, stick with the one closest to the target
+		Elite::Vector2 corner{ history.points[0] };
+		if ((history.size >= 3) && (history.points[0].DistanceSquared(history.points[2]) < 0.25f) && (history.points[1].DistanceSquared(target) < corner.DistanceSquared(target)) && HasLineOfSight(position, history.points[1]))
+		{
+			corner = history.points[1];
+		}
+
+		if (HasLineOfSight(position, target)) return target;
+
+		// Pull the string past the corner, as far towards the target as we can still see
+		const float cornerToTarget{ corner.Distance(target) };
+		if (cornerToTarget > FLT_EPSILON)
+		{
+			const Elite::Vector2 direction{ (target - corner) / cornerToTarget };
+			for (float distance{ std::min(m_LookAhead, cornerToTarget) }; distance > 0.5f; distance *= 0.5f)
+			{
+				const Elite::Vector2 point{ corner + (direction * distance) };
+				if (!IsInsideOtherObstacle(point, target) && HasLineOfSight(position, point)) return point;
+			}
+		}
+
+		return corner;
+	}
+
+	bool PathSmoother::HasLineOfSight(const Elite::Vector2& from, const Elite::Vector2& to) const
+	{
+		const Elite::Vector2 delta{ to - from };
+
+		return std::ranges::none_of(m_Obstacles, [&from, &to, &delta](const Obstacle& obstacle) -> bool
+			{
+				// Houses we are in or going into have doors we don't know about, the nav mesh handles those
+				if (Contains(obstacle, from) || Contains(obstacle, to)) return false;
+
+				// Slab test of the segment against the box
+				float segmentEntry{ 0.0f }, segmentExit{ 1.0f };
+				for (unsigned int axis{}; axis < 2; ++axis)
+				{
+					if (fabsf(delta[axis]) < FLT_EPSILON)
+					{
+						if ((from[axis] < obstacle.minimum[axis]) || (from[axis] > obstacle.maximum[axis])) return false;
+						continue;
+					}
+
+					float slabEntry{ (obstacle.minimum[axis] - from[axis]) / delta[axis] };
+					float slabExit{ (obstacle.maximum[axis] - from[axis]) / delta[axis] };
+					if (slabEntry > slabExit) std::swap(slabEntry, slabExit);
+
+					segmentEntry = std::max(segmentEntry, slabEntry);
+					segmentExit = std::min(segmentExit, slabExit);
+					if (segmentEntry > segmentExit) return false;
+				}
+
+				return true;
+			});
+	}
+
+	bool PathSmoother::IsInsideObstacle(const Elite::Vector2& point) const
+	{
+		return std::ranges::any_of(m_Obstacles, [&point](const Obstacle& obstacle) -> bool { return Contains(obstacle, point); });
+	}
+
+	bool PathSmoother::IsInsideOtherObstacle(const Elite::Vector2& point, const Elite::Vector2& target) const
+	{
+		return std::ranges::any_of(m_Obstacles, [&point, &target](const Obstacle& obstacle) -> bool
+			{
+				return Contains(obstacle, point) && !Contains(obstacle, target);
+			});
+	}
+
+	bool PathSmoother::Contains(const Obstacle& obstacle, const Elite::Vector2& point)
+	{
+		return (point.x >= obstacle.minimum.x) && (point.x <= obstacle.maximum.x) && (point.y >= obstacle.minimum.y) && (point.y <= obstacle.maximum.y);
+	}
+
+	void PathSmoother::AddToHistory(SmoothingHistory& history, const Elite::Vector2& pathPoint)
+	{
+		if ((history.size > 0) && (history.points[0].DistanceSquared(pathPoint) < 0.25f)) return;
+
+		std::shift_right(std::begin(history.points), std::end(history.points), 1);
+		history.points[0] = pathPoint;
+		history.size = std::min(history.size + 1, history.points.size());
+	}
+}
\ No newline at end of file
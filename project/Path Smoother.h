@@ -0,0 +1,56 @@
+#ifndef PATH_SMOOTHER
+#define PATH_SMOOTHER
+
+#include <vector>
+#include <array>
+
+namespace Navigation
+{
+	// The last distinct nav mesh points on the way to a target, newest first, every agent that gets smoothed keeps its own
+	struct SmoothingHistory final
+	{
+		std::array<Elite::Vector2, 4> points{};
+		size_t size{ 0 };
+		Elite::Vector2 target{};
+	};
+
+	// Turns the single next point the nav mesh gives us into a smoother target by cutting corners we can see past
+	class PathSmoother final
+	{
+	public:
+		PathSmoother(float agentRadius = 1.0f, float lookAhead = 10.0f);
+		~PathSmoother() = default;
+
+		PathSmoother(const PathSmoother&) = delete;
+		PathSmoother& operator=(const PathSmoother&) = delete;
+		PathSmoother(PathSmoother&&) = delete;
+		PathSmoother& operator=(PathSmoother&&) = delete;
+
+		// Houses are the only geometry we know, adding the same house twice is ignored
+		void AddObstacle(const Elite::Vector2& center, const Elite::Vector2& size);
+
+		// The point to steer to when the nav mesh tells us to go to pathPoint on our way to target, the houses are shared but the history is the agent's own
+		Elite::Vector2 Smooth(SmoothingHistory& history, const Elite::Vector2& position, const Elite::Vector2& pathPoint, const Elite::Vector2& target) const;
+		bool HasLineOfSight(const Elite::Vector2& from, const Elite::Vector2& to) const;
+
+	private:
+		struct Obstacle final
+		{
+			Elite::Vector2 center;
+			Elite::Vector2 minimum;
+			Elite::Vector2 maximum;
+		};
+
+		float m_AgentRadius;
+		float m_LookAhead;
+		std::vector<Obstacle> m_Obstacles;
+
+		bool IsInsideObstacle(const Elite::Vector2& point) const;
+		// Sampled points must not end up inside a house, unless it is the house we are going into
+		bool IsInsideOtherObstacle(const Elite::Vector2& point, const Elite::Vector2& target) const;
+		static bool Contains(const Obstacle& obstacle, const Elite::Vector2& point);
+		static void AddToHistory(SmoothingHistory& history, const Elite::Vector2& pathPoint);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "stdafx.h"
+#include "Perception.h"
+#include "IExamInterface.h"
+
+namespace
+{
+	// Polynomial atan2 without branches, within 0.00001 radians of AngleBetween and a lot cheaper, we take one for everything we see every tick
+	float FastAngleBetween(const Elite::Vector2& from, const Elite::Vector2& to)
+	{
+		const float x{ from.Dot(to) };
+		const float y{ from.Cross(to) };
+		const float absoluteX{ std::abs(x) };
+		const float absoluteY{ std::abs(y) };
+
+		// atan on [0, 1], swap around the diagonal and mirror into the right quadrant afterwards
+		const float ratio{ std::min(absoluteX, absoluteY) / std::max(std::max(absoluteX, absoluteY), FLT_MIN) };
+		const float square{ ratio * ratio };
+		float angle{ ratio * (0.99997726f + square * (-0.33262347f + square * (0.19354346f + square * (-0.11643287f + square * (0.05265332f + square * -0.01172120f))))) };
+		angle = (absoluteY > absoluteX) ? (float(E_PI) / 2.0f) - angle : angle;
+		angle = (x < 0.0f) ? float(E_PI) - angle : angle;
+		return std::copysign(angle, y);
+	}
+
+	// Insertion sort on distance, only a handful are in view and they arrive in about the same order every frame
+	template<typename Info, size_t Capacity, Containers::eOverflowPolicy OverflowPolicy>
+	void SortByDistance(const AgentInfo& agentInfo, Containers::StaticVector<Info, Capacity, OverflowPolicy>& infos, Containers::StaticVector<float, Capacity>& distances, Containers::StaticVector<float, Capacity>& angles)
+	{
+		distances.Resize(infos.size());
+		for (size_t index{}; index < infos.size(); ++index) distances[index] = agentInfo.Position.Distance(infos[index].Location);
+
+		for (size_t index{ 1 }; index < infos.size(); ++index)
+		{
+			const Info info{ infos[index] };
+			const float distance{ distances[index] };
+
+			size_t slot{ index };
+			while ((slot > 0) && (distances[slot - 1] > distance))
+			{
+				infos[slot] = infos[slot - 1];
+				distances[slot] = distances[slot - 1];
+				--slot;
+			}
+			infos[slot] = info;
+			distances[slot] = distance;
+		}
+
+		const Elite::Vector2 forward{ Elite::OrientationToVector(agentInfo.Orientation) };
+		angles.Resize(infos.size());
+		for (size_t index{}; index < infos.size(); ++index) angles[index] = FastAngleBetween(forward, infos[index].Location - agentInfo.Position);
+	}
+}
+
+void PerceptionFrame::Build(const IExamInterface* pInterface)
+{
+	// The interface hands us new vectors, from here on what we see lives inline and is copied without allocating
+	Build(pInterface->Agent_GetInfo(), pInterface->World_GetStats(), pInterface->FOV_GetStats(), pInterface->GetHousesInFOV(), pInterface->GetEnemiesInFOV(), pInterface->GetPurgeZonesInFOV(), pInterface->GetItemsInFOV());
+}
+
+void PerceptionFrame::Build(const AgentInfo& agentInfo, const StatisticsInfo& stats, const FOVStats& fovStats, std::span<const HouseInfo> houses, std::span<const EnemyInfo> enemies, std::span<const PurgeZoneInfo> purgeZones, std::span<const ItemInfo> items)
+{
+	Agent = agentInfo;
+	Stats = stats;
+	FOV = fovStats;
+	// Whatever doesn't fit, it is the far away ones we can do without
+	const Elite::Vector2 position{ agentInfo.Position };
+	Houses.AssignLowestCost(houses, [&position](const HouseInfo& house) -> float { return position.DistanceSquared(house.Center); });
+	PurgeZones.AssignLowestCost(purgeZones, [&position](const PurgeZoneInfo& zone) -> float { return position.Distance(zone.Center) - zone.Radius; });
+	Enemies.AssignLowestCost(enemies, [&position](const EnemyInfo& enemy) -> float { return position.DistanceSquared(enemy.Location); });
+	Items.AssignLowestCost(items, [&position](const ItemInfo& item) -> float { return position.DistanceSquared(item.Location); });
+
+	SortByDistance(Agent, Enemies, EnemyDistances, EnemyAngles);
+	SortByDistance(Agent, Items, ItemDistances, ItemAngles);
+}
+
+void PerceptionFrame::IgnoreItems(std::span<const int> itemHashes)
+{
+	// Shift the kept ones down, so the distances and angles still line up
+	size_t kept{};
+	for (size_t index{}; index < Items.size(); ++index)
+	{
+		if (std::ranges::find(itemHashes, Items[index].ItemHash) != std::end(itemHashes)) continue;
+
+		Items[kept] = Items[index];
+		ItemDistances[kept] = ItemDistances[index];
+		ItemAngles[kept] = ItemAngles[index];
+		++kept;
+	}
+
+	Items.Resize(kept);
+	ItemDistances.Resize(kept);
+	ItemAngles.Resize(kept);
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef PERCEPTION
+#define PERCEPTION
+
+#include "Exam_HelperStructs.h"
+#include "Static Vector.h"
+#include <span>
+
+class IExamInterface;
+
+// What we see in one frame, stored inline so the blackboard copies them without allocating
+// Sized with room to spare above what fits in our field of view at once, the plugin logs the most it saw and how many it dropped so these can be checked
+// A crowded frame is valid game input, so past the capacity only the nearest ones are kept (purge zones by distance to their edge)
+using HousesInFOV = Containers::StaticVector<HouseInfo, 16, Containers::eOverflowPolicy::Truncate>;
+using EnemiesInFOV = Containers::StaticVector<EnemyInfo, 64, Containers::eOverflowPolicy::Truncate>;
+using PurgeZonesInFOV = Containers::StaticVector<PurgeZoneInfo, 32, Containers::eOverflowPolicy::Truncate>;
+using ItemsInFOV = Containers::StaticVector<ItemInfo, 32, Containers::eOverflowPolicy::Truncate>;
+
+// Everything we perceive this tick, built once at the start of the tick so every state, condition and action reads the same snapshot
+struct PerceptionFrame final
+{
+	AgentInfo Agent{};
+	StatisticsInfo Stats{};
+	FOVStats FOV{};
+	HousesInFOV Houses{};
+	PurgeZonesInFOV PurgeZones{};
+
+	// Sorted from close to far, the distances and the angles we have to turn to face them (radians) line up with them
+	EnemiesInFOV Enemies{};
+	Containers::StaticVector<float, EnemiesInFOV::GetCapacity()> EnemyDistances{};
+	Containers::StaticVector<float, EnemiesInFOV::GetCapacity()> EnemyAngles{};
+	ItemsInFOV Items{};
+	Containers::StaticVector<float, ItemsInFOV::GetCapacity()> ItemDistances{};
+	Containers::StaticVector<float, ItemsInFOV::GetCapacity()> ItemAngles{};
+
+	void Build(const IExamInterface* pInterface);
+	// Same as above from data we already have, the benchmarks use this one
+	void Build(const AgentInfo& agentInfo, const StatisticsInfo& stats, const FOVStats& fovStats, std::span<const HouseInfo> houses, std::span<const EnemyInfo> enemies, std::span<const PurgeZoneInfo> purgeZones, std::span<const ItemInfo> items);
+
+	const EnemyInfo* GetClosestEnemy() const { return Enemies.empty() ? nullptr : &Enemies.front(); }
+	const ItemInfo* GetClosestItem() const { return Items.empty() ? nullptr : &Items.front(); }
+	// Takes items we gave up on out of the frame, the rest keeps its order
+	void IgnoreItems(std::span<const int> itemHashes);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "stdafx.h"
+#include "Random Generator.h"
+
+namespace MovementBehavior
+{
+	namespace
+	{
+		uint32_t RotateLeft(uint32_t value, int shift)
+		{
+			return (value << shift) | (value >> (32 - shift));
+		}
+	}
+
+	RandomGenerator::RandomGenerator(uint32_t seed) :
+		m_State{}
+	{
+		Seed(seed);
+	}
+
+	void RandomGenerator::Seed(uint32_t seed)
+	{
+		// Spread the seed over the whole state with splitmix32 so similar seeds still give different sequences
+		for (uint32_t& state : m_State)
+		{
+			seed += 0x9E3779B9u;
+			uint32_t mixed{ seed };
+			mixed = (mixed ^ (mixed >> 16)) * 0x85EBCA6Bu;
+			mixed = (mixed ^ (mixed >> 13)) * 0xC2B2AE35u;
+			state = mixed ^ (mixed >> 16);
+		}
+	}
+
+	uint32_t RandomGenerator::NextUInt()
+	{
+		const uint32_t result{ m_State[0] + m_State[3] };
+		const uint32_t shifted{ m_State[1] << 9 };
+
+		m_State[2] ^= m_State[0];
+		m_State[3] ^= m_State[1];
+		m_State[1] ^= m_State[2];
+		m_State[0] ^= m_State[3];
+		m_State[2] ^= shifted;
+		m_State[3] = RotateLeft(m_State[3], 11);
+
+		return result;
+	}
+
+	float RandomGenerator::NextFloat()
+	{
+		// The upper 24 bits are the best ones and fit exactly in a float mantissa, result is in [0, 1)
+		return float(NextUInt() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	float RandomGenerator::NextFloat(float min, float max)
+	{
+		return min + ((max - min) * NextFloat());
+	}
+
+	void RandomGenerator::FillFloats(float* pOutput, size_t count, float min, float max)
+	{
+		for (size_t index{}; index < count; ++index) pOutput[index] = NextFloat(min, max);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef RANDOM_GENERATOR
+#define RANDOM_GENERATOR
+
+#include <cstdint>
+#include <array>
+
+namespace MovementBehavior
+{
+	// Small xoshiro128+ generator, every behaviour owns its own so results are reproducible and nothing is shared between agents
+	class RandomGenerator final
+	{
+	public:
+		explicit RandomGenerator(uint32_t seed = 0);
+		~RandomGenerator() = default;
+
+		RandomGenerator(const RandomGenerator& other) = default;
+		RandomGenerator& operator=(const RandomGenerator& other) = default;
+		RandomGenerator(RandomGenerator&& other) = default;
+		RandomGenerator& operator=(RandomGenerator&& other) = default;
+
+		void Seed(uint32_t seed);
+		uint32_t NextUInt();
+		float NextFloat();
+		float NextFloat(float min, float max);
+		void FillFloats(float* pOutput, size_t count, float min, float max);
+
+	private:
+		std::array<uint32_t, 4> m_State;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "stdafx.h"
+#include "Spatial Grid.h"
+
+namespace Memory
+{
+	SpatialGrid::SpatialGrid(const WorldInfo& worldInfo, float cellSize) :
+		m_Origin{ worldInfo.Center - (worldInfo.Dimensions / 2.0f) },
+		m_CellSize{ cellSize },
+		m_Columns{ std::max(int(ceilf(worldInfo.Dimensions.x / cellSize)), 1) },
+		m_Rows{ std::max(int(ceilf(worldInfo.Dimensions.y / cellSize)), 1) },
+		m_Cells(size_t(m_Columns * m_Rows)),
+		m_Centers{},
+		m_HalfSizes{},
+		m_QueryIds{},
+		m_QueryId{ 0 }
+	{
+
+	}
+
+	void SpatialGrid::Insert(int id, const Elite::Vector2& center, const Elite::Vector2& size)
+	{
+		if (size_t(id) >= m_Centers.size())
+		{
+			m_Centers.resize(size_t(id) + 1);
+			m_HalfSizes.resize(size_t(id) + 1);
+			m_QueryIds.resize(size_t(id) + 1, 0);
+		}
+
+		const Elite::Vector2 halfSize{ size / 2.0f };
+		m_Centers[id] = center;
+		m_HalfSizes[id] = halfSize;
+
+		// Store the id in every cell the rectangle overlaps
+		for (int row{ GetRow(center.y - halfSize.y) }; row <= GetRow(center.y + halfSize.y); ++row)
+		{
+			for (int column{ GetColumn(center.x - halfSize.x) }; column <= GetColumn(center.x + halfSize.x); ++column)
+			{
+				m_Cells[size_t((row * m_Columns) + column)].push_back(id);
+			}
+		}
+	}
+
+	void SpatialGrid::QueryRectangle(const Elite::Vector2& minimum, const Elite::Vector2& maximum, std::vector<int>& ids) const
+	{
+		++m_QueryId;
+
+		for (int row{ GetRow(minimum.y) }; row <= GetRow(maximum.y); ++row)
+		{
+			for (int column{ GetColumn(minimum.x) }; column <= GetColumn(maximum.x); ++column)
+			{
+				for (int id : m_Cells[size_t((row * m_Columns) + column)])
+				{
+					if (m_QueryIds[id] == m_QueryId) continue;
+					m_QueryIds[id] = m_QueryId;
+
+					const Elite::Vector2& center{ m_Centers[id] };
+					const Elite::Vector2& halfSize{ m_HalfSizes[id] };
+					const bool overlaps{ ((center.x + halfSize.x) >= minimum.x) && ((center.x - halfSize.x) <= maximum.x) && ((center.y + halfSize.y) >= minimum.y) && ((center.y - halfSize.y) <= maximum.y) };
+					if (overlaps) ids.push_back(id);
+				}
+			}
+		}
+	}
+
+	void SpatialGrid::QueryRadius(const Elite::Vector2& position, float radius, std::vector<int>& ids) const
+	{
+		// Find the candidates in the bounding box of the circle, then keep the ones whose rectangle is within the radius
+		const size_t firstCandidate{ ids.size() };
+		QueryRectangle(position - Elite::Vector2{ radius, radius }, position + Elite::Vector2{ radius, radius }, ids);
+
+		const auto itRemoved{ std::remove_if(std::begin(ids) + firstCandidate, std::end(ids), [this, &position, radius](int id) -> bool
+			{
+				const Elite::Vector2& center{ m_Centers[id] };
+				const Elite::Vector2& halfSize{ m_HalfSizes[id] };
+				const Elite::Vector2 closestPoint{ std::clamp(position.x, center.x - halfSize.x, center.x + halfSize.x), std::clamp(position.y, center.y - halfSize.y, center.y + halfSize.y) };
+
+				return closestPoint.DistanceSquared(position) > (radius * radius);
+			}) };
+		ids.erase(itRemoved, std::end(ids));
+	}
+
+	int SpatialGrid::GetColumn(float x) const
+	{
+		return std::clamp(int(floorf((x - m_Origin.x) / m_CellSize)), 0, m_Columns - 1);
+	}
+
+	int SpatialGrid::GetRow(float y) const
+	{
+		return std::clamp(int(floorf((y - m_Origin.y) / m_CellSize)), 0, m_Rows - 1);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef SPATIAL_GRID
+#define SPATIAL_GRID
+
+#include "Exam_HelperStructs.h"
+#include <vector>
+
+namespace Memory
+{
+	// Uniform grid over the world for rectangles that never move, indexed by dense ids (0, 1, 2, ...)
+	class SpatialGrid final
+	{
+	public:
+		SpatialGrid(const WorldInfo& worldInfo, float cellSize = 50.0f);
+		~SpatialGrid() = default;
+
+		SpatialGrid(const SpatialGrid&) = delete;
+		SpatialGrid& operator=(const SpatialGrid&) = delete;
+		SpatialGrid(SpatialGrid&&) = delete;
+		SpatialGrid& operator=(SpatialGrid&&) = delete;
+
+		void Insert(int id, const Elite::Vector2& center, const Elite::Vector2& size);
+
+		// The queries add the ids they find to ids, they don't clear it first
+		void QueryRectangle(const Elite::Vector2& minimum, const Elite::Vector2& maximum, std::vector<int>& ids) const;
+		void QueryRadius(const Elite::Vector2& position, float radius, std::vector<int>& ids) const;
+
+		// The count closest rectangles (by center) for which filter(int id) returns true, closest first
+		template<typename Filter>
+		void QueryNearest(const Elite::Vector2& position, size_t count, std::vector<int>& ids, Filter filter) const
+		{
+			const size_t firstResult{ ids.size() };
+			if (count == 0) return;
+
+			// Look at rings of cells around us, a ring further out can't hold anything closer than its inner edge
+			const int column{ GetColumn(position.x) };
+			const int row{ GetRow(position.y) };
+			const int maximumRing{ std::max({ column, row, m_Columns - 1 - column, m_Rows - 1 - row }) };
+			++m_QueryId;
+
+			for (int ring{}; ring <= maximumRing; ++ring)
+			{
+				if ((ids.size() - firstResult) >= count)
+				{
+					const float ringDistance{ (float(ring) - 1.0f) * m_CellSize };
+					if ((ringDistance > 0.0f) && ((ringDistance * ringDistance) > m_Centers[ids.back()].DistanceSquared(position))) break;
+				}
+
+				for (int ringRow{ row - ring }; ringRow <= (row + ring); ++ringRow)
+				{
+					for (int ringColumn{ column - ring }; ringColumn <= (column + ring); ++ringColumn)
+					{
+						const bool onRing{ (std::abs(ringRow - row) == ring) || (std::abs(ringColumn - column) == ring) };
+						if (!onRing || (ringColumn < 0) || (ringColumn >= m_Columns) || (ringRow < 0) || (ringRow >= m_Rows)) continue;
+
+						for (int id : m_Cells[size_t((ringRow * m_Columns) + ringColumn)])
+						{
+							if ((m_QueryIds[id] == m_QueryId) || !filter(id)) continue;
+							m_QueryIds[id] = m_QueryId;
+
+							// Keep the results sorted and at most count long
+							const float distance{ m_Centers[id].DistanceSquared(position) };
+							auto itPosition{ std::find_if(std::begin(ids) + firstResult, std::end(ids), [this, &position, distance](int other) -> bool { return m_Centers[other].DistanceSquared(position) > distance; }) };
+							if (size_t(std::distance(std::begin(ids) + firstResult, itPosition)) >= count) continue;
+
+							ids.insert(itPosition, id);
+							if ((ids.size() - firstResult) > count) ids.pop_back();
+						}
+					}
+				}
+			}
+		}
+
+	private:
+		Elite::Vector2 m_Origin;
+		float m_CellSize;
+		int m_Columns;
+		int m_Rows;
+		std::vector<std::vector<int>> m_Cells;
+		std::vector<Elite::Vector2> m_Centers;
+		std::vector<Elite::Vector2> m_HalfSizes;
+
+		// A rectangle can be in several cells, these make sure a query reports it only once
+		mutable std::vector<unsigned int> m_QueryIds;
+		mutable unsigned int m_QueryId;
+
+		int GetColumn(float x) const;
+		int GetRow(float y) const;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "stdafx.h"
+#include "Spatial Hash.h"
+
+namespace MovementBehavior
+{
+	SpatialHash::SpatialHash(float cellSize, size_t bucketCount) :
+		m_Buckets(bucketCount),
+		m_CellSize{ cellSize },
+		m_MaximumRadius{ 0.0f },
+		m_Size{ 0 }
+	{
+
+	}
+
+	void SpatialHash::Clear()
+	{
+		// Clearing keeps the capacity of every bucket, so refilling every frame doesn't allocate
+		for (std::vector<Entry>& bucket : m_Buckets) bucket.clear();
+		m_MaximumRadius = 0.0f;
+		m_Size = 0;
+	}
+
+	void SpatialHash::Insert(const Elite::Vector2& position, float radius)
+	{
+		const int cellX{ CellCoordinate(position.x) };
+		const int cellY{ CellCoordinate(position.y) };
+
+		m_Buckets[BucketIndex(cellX, cellY)].push_back(Entry{ position, radius, cellX, cellY });
+		m_MaximumRadius = std::max(m_MaximumRadius, radius);
+		++m_Size;
+	}
+
+	size_t SpatialHash::Size() const
+	{
+		return m_Size;
+	}
+
+	int SpatialHash::CellCoordinate(float value) const
+	{
+		return int(floorf(value / m_CellSize));
+	}
+
+	size_t SpatialHash::BucketIndex(int cellX, int cellY) const
+	{
+		const size_t hash{ (size_t(uint32_t(cellX)) * 73856093u) ^ (size_t(uint32_t(cellY)) * 19349663u) };
+		return hash % m_Buckets.size();
+	}
+}
\ No newline at end of file
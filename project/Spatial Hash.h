@@ -0,0 +1,70 @@
+#ifndef SPATIAL_HASH
+#define SPATIAL_HASH
+
+#include <vector>
+
+namespace MovementBehavior
+{
+	// Hashes points into a fixed amount of buckets so neighbour queries only look at the few points near us
+	class SpatialHash final
+	{
+	public:
+		struct Entry final
+		{
+			Elite::Vector2 position;
+			float radius;
+			int cellX;
+			int cellY;
+		};
+
+		explicit SpatialHash(float cellSize = 4.0f, size_t bucketCount = 128);
+		~SpatialHash() = default;
+
+		SpatialHash(const SpatialHash& other) = delete;
+		SpatialHash& operator=(const SpatialHash& other) = delete;
+		SpatialHash(SpatialHash&& other) = delete;
+		SpatialHash& operator=(SpatialHash&& other) = delete;
+
+		void Clear();
+		void Insert(const Elite::Vector2& position, float radius = 0.0f);
+		size_t Size() const;
+
+		// Calls function(const Entry&) for every entry that overlaps the circle
+		template<typename Function>
+		void Query(const Elite::Vector2& position, float radius, Function function) const
+		{
+			// Entries are only stored in the cell of their center, so grow the search by the biggest radius we stored
+			const float searchRadius{ radius + m_MaximumRadius };
+			const int minimumCellX{ CellCoordinate(position.x - searchRadius) };
+			const int maximumCellX{ CellCoordinate(position.x + searchRadius) };
+			const int minimumCellY{ CellCoordinate(position.y - searchRadius) };
+			const int maximumCellY{ CellCoordinate(position.y + searchRadius) };
+
+			for (int cellY{ minimumCellY }; cellY <= maximumCellY; ++cellY)
+			{
+				for (int cellX{ minimumCellX }; cellX <= maximumCellX; ++cellX)
+				{
+					for (const Entry& entry : m_Buckets[BucketIndex(cellX, cellY)])
+					{
+						// Different cells can share a bucket, skip those so nothing is visited twice
+						if ((entry.cellX != cellX) || (entry.cellY != cellY)) continue;
+
+						const float reach{ radius + entry.radius };
+						if (position.DistanceSquared(entry.position) <= (reach * reach)) function(entry);
+					}
+				}
+			}
+		}
+
+	private:
+		std::vector<std::vector<Entry>> m_Buckets;
+		float m_CellSize;
+		float m_MaximumRadius;
+		size_t m_Size;
+
+		int CellCoordinate(float value) const;
+		size_t BucketIndex(int cellX, int cellY) const;
+	};
+}
+
+#endif
\ No newline at end of file
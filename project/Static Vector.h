@@ -0,0 +1,158 @@
+#ifndef STATIC_VECTOR
+#define STATIC_VECTOR
+
+#include <array>
+#include <span>
+#include <cassert>
+#include <algorithm>
+
+namespace Containers
+{
+	// What happens to the elements that don't fit anymore
+	enum class eOverflowPolicy
+	{
+		// Keep the first elements (or the cheapest ones with AssignLowestCost) and count the ones we dropped
+		Truncate,
+		// Same as truncate, but asserts in debug so the capacity gets raised
+		Assert
+	};
+
+	// Vector with its elements stored inline, it never allocates so copying it around every frame stays cheap
+	template<typename Type, size_t Capacity, eOverflowPolicy OverflowPolicy = eOverflowPolicy::Truncate>
+	class StaticVector final
+	{
+	public:
+		StaticVector() :
+			m_Elements{},
+			m_Size{ 0 },
+			m_Dropped{ 0 }
+		{
+
+		}
+		// Implicit so the vectors the interface hands us can be stored as is
+		StaticVector(std::span<const Type> elements) :
+			StaticVector{}
+		{
+			Assign(elements);
+		}
+		~StaticVector() = default;
+
+		StaticVector(const StaticVector&) = default;
+		StaticVector& operator=(const StaticVector&) = default;
+		StaticVector(StaticVector&&) = default;
+		StaticVector& operator=(StaticVector&&) = default;
+
+		void Assign(std::span<const Type> elements)
+		{
+			Clear();
+			for (const Type& element : elements) PushBack(element);
+		}
+
+		// Same as Assign, but when there are too many the ones with the lowest cost are kept instead of the first ones
+		template<typename CostFunction>
+		void AssignLowestCost(std::span<const Type> elements, CostFunction cost)
+		{
+			if (elements.size() <= Capacity)
+			{
+				Assign(elements);
+				return;
+			}
+
+			// Fill up, then every other element replaces the most expensive one we kept if it is cheaper
+			Clear();
+			std::array<float, Capacity> costs{};
+			for (size_t index{}; index < Capacity; ++index)
+			{
+				m_Elements[index] = elements[index];
+				costs[index] = cost(elements[index]);
+			}
+			m_Size = Capacity;
+			for (size_t index{ Capacity }; index < elements.size(); ++index)
+			{
+				const float elementCost{ cost(elements[index]) };
+				const auto mostExpensive{ std::ranges::max_element(costs) };
+				if (elementCost >= *mostExpensive) continue;
+
+				m_Elements[size_t(mostExpensive - costs.begin())] = elements[index];
+				*mostExpensive = elementCost;
+			}
+
+			m_Dropped = elements.size() - Capacity;
+			if constexpr (OverflowPolicy == eOverflowPolicy::Assert) assert(false && "StaticVector is full");
+		}
+
+		// Returns false when the element didn't fit
+		bool PushBack(const Type& element)
+		{
+			if (m_Size == Capacity)
+			{
+				++m_Dropped;
+				if constexpr (OverflowPolicy == eOverflowPolicy::Assert) assert(false && "StaticVector is full");
+				return false;
+			}
+
+			m_Elements[m_Size] = element;
+			++m_Size;
+			return true;
+		}
+
+		// Grows with default elements or shrinks, anything past the capacity counts as dropped
+		void Resize(size_t size)
+		{
+			if (size > Capacity)
+			{
+				m_Dropped += size - Capacity;
+				if constexpr (OverflowPolicy == eOverflowPolicy::Assert) assert(false && "StaticVector is full");
+				size = Capacity;
+			}
+
+			for (size_t index{ m_Size }; index < size; ++index) m_Elements[index] = Type{};
+			m_Size = size;
+		}
+
+		void PopBack()
+		{
+			if (m_Size > 0) --m_Size;
+		}
+
+		void Clear()
+		{
+			m_Size = 0;
+			m_Dropped = 0;
+		}
+
+		// Elements that didn't fit since the last clear
+		size_t GetDropped() const
+		{
+			return m_Dropped;
+		}
+
+		static constexpr size_t GetCapacity()
+		{
+			return Capacity;
+		}
+
+		// Named like the standard containers so ranges and range based for loops work on it
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+		Type* data() { return m_Elements.data(); }
+		const Type* data() const { return m_Elements.data(); }
+		Type* begin() { return m_Elements.data(); }
+		const Type* begin() const { return m_Elements.data(); }
+		Type* end() { return m_Elements.data() + m_Size; }
+		const Type* end() const { return m_Elements.data() + m_Size; }
+		Type& operator[](size_t index) { return m_Elements[index]; }
+		const Type& operator[](size_t index) const { return m_Elements[index]; }
+		Type& front() { return m_Elements[0]; }
+		const Type& front() const { return m_Elements[0]; }
+		Type& back() { return m_Elements[m_Size - 1]; }
+		const Type& back() const { return m_Elements[m_Size - 1]; }
+
+	private:
+		std::array<Type, Capacity> m_Elements;
+		size_t m_Size;
+		size_t m_Dropped;
+	};
+}
+
+#endif
\ No newline at end of file
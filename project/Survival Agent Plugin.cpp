@@ -8,20 +8,37 @@
 #include "FSM Conditions.h"
 #include "Behaviour Tree.h"
 #include "BT Actions.h"
-#include <unordered_set>
+#include "Navigation Grid.h"
+#include "Path Planner.h"
+#include "Path Scheduler.h"
+#include "Flow Field.h"
+#include "Path Smoother.h"
+#include "Tour Optimizer.h"
+#include "Sweep Planner.h"
+#include "House Registry.h"
+#include "Enemy Tracker.h"
+#include "Threat Map.h"
+#include "Coverage Map.h"
+#include "Zone Registry.h"
+#include "Item Memory.h"
+#include "Flat Hash Map.h"
+#include "Inventory.h"
+#include "Inventory Optimizer.h"
+#include "Target Selector.h"
+#include "Aim Controller.h"
+#include "Perception.h"
 #include <unordered_map>
 #include <algorithm>
 #include <iterator>
 #include <array>
-#include <tuple>
+#include <chrono>
 
 using namespace Elite;
 
 void SurvivalAgentPlugin::Initialize(IBaseInterface* pInterface, PluginInfo& pluginInfo)
 {
-	// Store our interface and set our pathfinding function for our behaviours
+	// Store our interface
 	m_Interface = dynamic_cast<IExamInterface*>(pInterface);
-	MovementBehavior::ISteeringBehavior::SetPathfindingFunction(m_Interface, &IExamInterface::NavMesh_GetClosestPathPoint);
 
 	// Information for the leaderboard
 	pluginInfo.BotName = "John";
@@ -102,7 +119,8 @@ void SurvivalAgentPlugin::Initialize(IBaseInterface* pInterface, PluginInfo& plu
 	DecisionMaking::BehaviourTree::IBehaviour* shooting{ new DecisionMaking::BehaviourTree::Action{&DecisionMaking::BehaviourTree::CheckShooting} };
 	DecisionMaking::BehaviourTree::IBehaviour* healing{ new DecisionMaking::BehaviourTree::Action{&DecisionMaking::BehaviourTree::CheckHealing} };
 	DecisionMaking::BehaviourTree::IBehaviour* food{ new DecisionMaking::BehaviourTree::Action{&DecisionMaking::BehaviourTree::CheckFood} };
-	DecisionMaking::BehaviourTree::IBehaviour* root{ new DecisionMaking::BehaviourTree::Sequence{ std::vector<DecisionMaking::BehaviourTree::IBehaviour*>{ shooting, healing, food } } };
+	DecisionMaking::BehaviourTree::IBehaviour* dropping{ new DecisionMaking::BehaviourTree::Action{&DecisionMaking::BehaviourTree::CheckDropping} };
+	DecisionMaking::BehaviourTree::IBehaviour* root{ new DecisionMaking::BehaviourTree::Sequence{ std::vector<DecisionMaking::BehaviourTree::IBehaviour*>{ shooting, healing, food, dropping } } };
 	m_InventoryBehaviourTree = new DecisionMaking::BehaviourTree::Tree{ m_Blackboard, root };
 }
 
@@ -129,7 +147,7 @@ void SurvivalAgentPlugin::InitGameDebugParams(GameDebugParams& debugParameters)
 	debugParameters.RenderUI = true;
 	debugParameters.AutoGrabClosestItem = false;
 	debugParameters.LevelFile = "GameLevel.gppl";
-	debugParameters.Seed = 4;
+	debugParameters.Seed = m_Seed;
 	debugParameters.StartingDifficultyStage = 1;
 	debugParameters.InfiniteStamina = false;
 	debugParameters.SpawnDebugPistol = false;
@@ -147,9 +165,43 @@ void SurvivalAgentPlugin::Update_Debug(float deltaTime)
 
 SteeringPlugin_Output SurvivalAgentPlugin::UpdateSteering(float deltaTime)
 {
+	const auto tickStart{ std::chrono::steady_clock::now() };
+
 	UpdateBlackboard(deltaTime);
 	m_ExplorationFiniteStateMachine->Update(deltaTime);
 	m_InventoryBehaviourTree->Update(deltaTime);
+	ApplyAimRequest(deltaTime);
+
+	// Spend the rest of the frame on the path requests the states made, every change to the grid was made while updating the blackboard
+	Navigation::NavigationGrid* grid{};
+	m_Blackboard->GetData("NavigationGrid", grid);
+	Navigation::PathScheduler* pathScheduler{};
+	m_Blackboard->GetData("PathScheduler", pathScheduler);
+	pathScheduler->Invalidate(grid->GetChangedCells());
+	pathScheduler->Update(m_PathBudget);
+
+	Navigation::TourOptimizer* tourOptimizer{};
+	m_Blackboard->GetData("TourOptimizer", tourOptimizer);
+	tourOptimizer->Update(m_TourBudget);
+
+	// Let the flow field pick up this frame's changes, every planner had its chance to repair with them now
+	Navigation::FlowField* flowField{};
+	m_Blackboard->GetData("SafetyFlowField", flowField);
+	flowField->Update(deltaTime, m_FlowFieldBudget);
+	grid->ClearChangedCells();
+
+	// Report the average time a tick costs us every few thousand ticks
+	std::pair<float, int>* tickStatistics{};
+	m_Blackboard->GetData("TickStatistics", tickStatistics);
+	tickStatistics->first += float(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tickStart).count());
+	if (++tickStatistics->second == 3600)
+	{
+		std::cout << "Tick time: " << (tickStatistics->first / float(tickStatistics->second)) << "us on average over " << tickStatistics->second << " ticks" << std::endl;
+		std::cout << "Most seen at once: " << m_LargestInFOV[0] << " houses, " << m_LargestInFOV[1] << " enemies, " << m_LargestInFOV[2] << " purge zones and " << m_LargestInFOV[3] << " items" << std::endl;
+		std::cout << "Dropped the farthest because they didn't fit: " << m_DroppedInFOV[0] << " houses, " << m_DroppedInFOV[1] << " enemies, " << m_DroppedInFOV[2] << " purge zones and " << m_DroppedInFOV[3] << " items" << std::endl;
+		m_DroppedInFOV = std::array<size_t, 4>{};
+		*tickStatistics = std::pair<float, int>{ 0.0f, 0 };
+	}
 
 	SteeringPlugin_Output* output{};
 	m_Blackboard->GetData("SteeringOutput", output);
@@ -165,6 +217,14 @@ void SurvivalAgentPlugin::Render(float deltaTime) const
 	m_Interface->Draw_Direction(agentInfo.Position, agentInfo.LinearVelocity.GetNormalized(), 15.0f, Vector3{ 1.0f, 0.0f, 0.0f });
 	m_Interface->Draw_Direction(agentInfo.Position, Elite::OrientationToVector(agentInfo.Orientation), 15.0f, Vector3{ 0.0f, 1.0f, 0.0f });
 
+	// Draw where we think the zombies we don't see anymore are in red
+	Memory::EnemyTracker* enemyTracker{};
+	m_Blackboard->GetData("EnemyTracker", enemyTracker);
+	for (size_t track{}; track < enemyTracker->GetCount(); ++track)
+	{
+		if (enemyTracker->GetAge(track) > 0.0f) m_Interface->Draw_Circle(enemyTracker->GetPosition(track), enemyTracker->GetSize(track), Elite::Vector3{ 1.0f, 0.0f, 0.0f });
+	}
+
 	FOVStats fovStats{};
 	m_Blackboard->GetData("FOVStats", fovStats);
 
@@ -190,13 +250,13 @@ void SurvivalAgentPlugin::Render(float deltaTime) const
 	// Debug the entrance / exit to our current in blue
 	if (m_ExplorationFiniteStateMachine->AtState(m_LeaveHouse))
 	{
-		HouseInfo* currentHouse{};
+		int currentHouse{};
 		m_Blackboard->GetData("CurrentHouse", currentHouse);
 
-		std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-		m_Blackboard->GetData("FoundHouses", foundHouses);
+		Memory::HouseRegistry* houseRegistry{};
+		m_Blackboard->GetData("HouseRegistry", houseRegistry);
 
-		m_Interface->Draw_Point(std::get<1>(foundHouses->at(*currentHouse)), 3.0f, Elite::Vector3{ 0.0f, 0.0f, 1.0f });
+		m_Interface->Draw_Point(houseRegistry->GetEntrance(currentHouse), 3.0f, Elite::Vector3{ 0.0f, 0.0f, 1.0f });
 	}
 	// Debug our safe seek point in blue
 	else if (m_ExplorationFiniteStateMachine->AtState(m_SafeSeek))
@@ -209,19 +269,25 @@ void SurvivalAgentPlugin::Render(float deltaTime) const
 	// Debug the center of the unexplored house we are currently going to in blue
 	else if (m_ExplorationFiniteStateMachine->AtState(m_GetInsideUnexploredHouse))
 	{
-		HouseInfo* currentHouse{};
+		int currentHouse{};
 		m_Blackboard->GetData("CurrentHouse", currentHouse);
-		m_Interface->Draw_Point(currentHouse->Center, 3.0f, Elite::Vector3{ 0.0f, 0.0f, 1.0f });
+
+		Memory::HouseRegistry* houseRegistry{};
+		m_Blackboard->GetData("HouseRegistry", houseRegistry);
+		m_Interface->Draw_Point(houseRegistry->GetCenter(currentHouse), 3.0f, Elite::Vector3{ 0.0f, 0.0f, 1.0f });
+
+		std::vector<Elite::Vector2>* path{};
+		m_Blackboard->GetData("HousePath", path);
+		if (path->size() > 1) m_Interface->Draw_Segment(agentInfo.Position, path->front(), Elite::Vector3{ 0.0f, 0.0f, 1.0f });
+		for (size_t index{ 1 }; index < path->size(); ++index) m_Interface->Draw_Segment(path->at(index - 1), path->at(index), Elite::Vector3{ 0.0f, 0.0f, 1.0f });
 	}
 	// Draw the inside path / tour route of our current house in blue
 	else if (m_ExplorationFiniteStateMachine->AtState(m_ExploreHouse))
 	{
-		std::array<std::pair<bool, Elite::Vector2>, 4>* path;
+		std::pair<int, std::vector<std::pair<bool, Elite::Vector2>>>* path{};
 		m_Blackboard->GetData("InHousePath", path);
 
-		std::array<Elite::Vector2, 4> points { path->at(0).second, path->at(1).second, path->at(2).second, path->at(3).second };
-
-		m_Interface->Draw_Polygon(points.data(), 4, Elite::Vector3{ 0.0f, 0.0f, 1.0f });
+		for (size_t index{ 1 }; index < path->second.size(); ++index) m_Interface->Draw_Segment(path->second.at(index - 1).second, path->second.at(index).second, Elite::Vector3{ 0.0f, 0.0f, 1.0f });
 	}
 	// Draw a blue dot at the location of our target item
 	else if (m_ExplorationFiniteStateMachine->AtState(m_GetItem))
@@ -246,59 +312,128 @@ void SurvivalAgentPlugin::CreateBlackboard()
 	m_Blackboard->AddData("Interface", m_Interface);
 
 	// Movement behaviors
-	MovementBehavior::ISteeringBehavior* steering{ new MovementBehavior::Seek{} };
+		// Cuts the corners of the nav mesh path where the known houses let us
+	Navigation::PathSmoother* pathSmoother{ new Navigation::PathSmoother{} };
+	m_Blackboard->AddData("PathSmoother", pathSmoother);
+		// Every behaviour that moves goes through the nav mesh, the ones going for a target also through the smoother unless we compare against the raw nav mesh points
+	MovementBehavior::PathFunctions pathFunctions{};
+	pathFunctions.pathfinding = [pInterface = m_Interface](const Elite::Vector2& point) -> Elite::Vector2 { return pInterface->NavMesh_GetClosestPathPoint(point); };
+	if (m_UsePathSmoothing)
+	{
+		pathFunctions.smoothing = [pathSmoother](Navigation::SmoothingHistory& history, const Elite::Vector2& position, const Elite::Vector2& pathPoint, const Elite::Vector2& target) -> Elite::Vector2
+			{
+				return pathSmoother->Smooth(history, position, pathPoint, target);
+			};
+	}
+	MovementBehavior::ISteeringBehavior* steering{ new MovementBehavior::Seek{ pathFunctions } };
 	m_Blackboard->AddData("Seek", steering);
-	steering = new MovementBehavior::Flee{};
+	steering = new MovementBehavior::Flee{ pathFunctions };
 	m_Blackboard->AddData("Flee", steering);
-	steering = new MovementBehavior::Arrive{};
-	m_Blackboard->AddData("Arrive", steering);
-	steering = new MovementBehavior::Pursuit{};
+	MovementBehavior::Arrive* arrive{ new MovementBehavior::Arrive{ pathFunctions, 4.0f, 1.0f } };
+	m_Blackboard->AddData("Arrive", arrive);
+	steering = new MovementBehavior::Pursuit{ pathFunctions };
 	m_Blackboard->AddData("Pursuit", steering);
-	steering = new MovementBehavior::Evade{};
+	steering = new MovementBehavior::Evade{ pathFunctions };
 	m_Blackboard->AddData("Evade", steering);
-	steering = new MovementBehavior::Wander{};
+	steering = new MovementBehavior::Wander{ pathFunctions, 6.0f, 4.0f, Elite::ToRadians(70.0f), uint32_t(m_Seed) };
 	m_Blackboard->AddData("Wander", steering);
+	MovementBehavior::ContextSteering* contextSteering{ new MovementBehavior::ContextSteering{ pathFunctions } };
+	m_Blackboard->AddData("ContextSteering", contextSteering);
+	MovementBehavior::Separation* separation{ new MovementBehavior::Separation{} };
+	m_Blackboard->AddData("Separation", separation);
+		// The blend owns its behaviours, arrive and separation are also stored on their own so we can tweak them and feed them neighbours and walls
+	steering = new MovementBehavior::BlendedSteering{ { { arrive, 1.0f }, { separation, 1.0f } } };
+	m_Blackboard->AddData("ArriveWithSeparation", steering);
 	m_Blackboard->AddData("SteeringOutput", new SteeringPlugin_Output{});
 
 	// Exam Help structs
 	m_Blackboard->AddData("WorldInfo", m_Interface->World_GetInfo());
 	m_Blackboard->AddData("StatisticsInfo", StatisticsInfo{});
-	m_Blackboard->AddData("Houses", std::vector<HouseInfo>{});
-	m_Blackboard->AddData("Enemies", std::vector<EnemyInfo>{});
-	m_Blackboard->AddData("PurgeZones", std::vector<PurgeZoneInfo>{});
-	m_Blackboard->AddData("Items", std::vector<ItemInfo>{});
 	m_Blackboard->AddData("FOVStats", FOVStats{});
 	m_Blackboard->AddData("AgentInfo", AgentInfo{});
 
+	// Perception
+		// Everything we perceive this tick, with the enemies and items sorted from close to far
+	m_Blackboard->AddData("Perception", new PerceptionFrame{});
+		// First element is the microseconds our ticks took since the last report and the second is the amount of ticks
+	m_Blackboard->AddData("TickStatistics", new std::pair<float, int>{ 0.0f, 0 });
+
+	// Navigation
+		// Cost grid over the whole world, walls of known houses and places with zombies are expensive
+	Navigation::NavigationGrid* grid{ new Navigation::NavigationGrid{ m_Interface->World_GetInfo() } };
+	m_Blackboard->AddData("NavigationGrid", grid);
+		// Path requests of the states, worked on a little every frame so long searches never stall the game
+	m_Blackboard->AddData("PathScheduler", new Navigation::PathScheduler{ grid });
+		// Path to the house we are going to, repaired instead of replanned when the grid changes
+	m_Blackboard->AddData("HousePathPlanner", new Navigation::DStarLite{ grid });
+		// The waypoints of the planned path to the house we are going to
+	m_Blackboard->AddData("HousePath", new std::vector<Elite::Vector2>{});
+		// Direction away from purge zones and zombies for every cell of the navigation grid
+	m_Blackboard->AddData("SafetyFlowField", new Navigation::FlowField{ grid });
+		// First element is the distance we travelled and the second is the amount of houses we explored
+	m_Blackboard->AddData("TravelStatistics", new std::pair<float, int>{ 0.0f, 0 });
+		// Order to visit the unexplored houses we know in, starting from where we are
+	m_Blackboard->AddData("TourOptimizer", new Navigation::TourOptimizer{});
+
 	// Exploration
 		// First element is the counter and the second is the count the counter has to reach
 	m_Blackboard->AddData("EscapeTimer", new std::pair<float, float>{ 0.0f, 3.0f });	
 		// Point used when running away from a certain things
 	m_Blackboard->AddData("SafePoint", new Elite::Vector2{});
+		// First element is the id of the path request to the safe point and the second the path once it is found
+	m_Blackboard->AddData("SafePointPath", new std::pair<unsigned int, std::vector<Elite::Vector2>>{ 0, std::vector<Elite::Vector2>{} });
 		// Orientation that corrosponds to the player's back
 	m_Blackboard->AddData("CheckBehindOrientation", 0.0f);
-		// A map / dictionary with the house info as key
-		// The value will be a tuple of: an is explored bool, the entrance position Elite::Vector2, and a set of known items in the house
-	m_Blackboard->AddData("FoundHouses", new std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>{});
-		// A pointer to the house info about our current house
-	HouseInfo* currentHouse{ nullptr };
-	m_Blackboard->AddData("CurrentHouse", currentHouse);
-		// The path / tour used to explore the inside of a house
-	m_Blackboard->AddData("InHousePath", new std::array<std::pair<bool, Elite::Vector2>, 4>);
+		// Every house we found with its explored flag, entrance and the items we know are still inside
+	m_Blackboard->AddData("HouseRegistry", new Memory::HouseRegistry{ m_Interface->World_GetInfo() });
+		// The id of our current house in the house registry
+	m_Blackboard->AddData("CurrentHouse", Memory::HouseRegistry::InvalidId);
+		// Every zombie we saw recently, also the ones that left our field of view
+	m_Blackboard->AddData("EnemyTracker", new Memory::EnemyTracker{});
+		// Where we saw zombies lately, weighted by how dangerous they are
+	m_Blackboard->AddData("ThreatMap", new Memory::ThreatMap{ m_Interface->World_GetInfo() });
+		// Every purge zone we saw that should still be there
+	m_Blackboard->AddData("ZoneRegistry", new Memory::ZoneRegistry{});
+		// Every item we saw anywhere that should still be there
+	m_Blackboard->AddData("ItemMemory", new Memory::ItemMemory{});
+		// Hashes of the remembered items roaming already reopened the house of (or found outside of every house), each item is only looked up once
+	m_Blackboard->AddData("CheckedItems", new Containers::FlatHashSet<int>{ 256 });
+		// Filled with the houses around a remembered item, kept so roaming doesn't allocate a new list every tick
+	m_Blackboard->AddData("HouseQueryResults", new std::vector<int>{});
+		// Every part of the world we have had in our field of view
+	m_Blackboard->AddData("CoverageMap", new Memory::CoverageMap{ m_Interface->World_GetInfo() });
+		// First element is the time since the last coverage report and the second is the coverage at that report
+	m_Blackboard->AddData("CoverageStatistics", new std::pair<float, float>{ 0.0f, 0.0f });
+		// The edge of the seen part of the world we are roaming to
+	m_Blackboard->AddData("RoamTarget", new std::pair<bool, Elite::Vector2>{ false, Elite::Vector2{} });
+		// The points we walk past to see the whole inside of a house, first element is the house they are for
+	m_Blackboard->AddData("InHousePath", new std::pair<int, std::vector<std::pair<bool, Elite::Vector2>>>{ Memory::HouseRegistry::InvalidId, {} });
+		// Plans the in house path from our field of view
+	m_Blackboard->AddData("SweepPlanner", new Navigation::SweepPlanner{});
+		// When we started sweeping the current house
+	m_Blackboard->AddData("HouseEnterTime", 0.0f);
+		// First element is the total time spent exploring houses and the second is the amount of houses we explored
+	m_Blackboard->AddData("ExploreStatistics", new std::pair<float, int>{ 0.0f, 0 });
 		// Target item, will be used to go for items
 	m_Blackboard->AddData("TargetItem", new ItemInfo{});
+		// Time spent going for the current target item
+	m_Blackboard->AddData("GrabTimer", 0.0f);
+		// First element is the closest we got to the target item and the second is how long ago we last got a good bit closer
+	m_Blackboard->AddData("GrabProgress", new std::pair<float, float>{ FLT_MAX, 0.0f });
+		// How long we keep going for an item without getting closer before we give up on it
+	m_Blackboard->AddData("GrabStuckTime", 3.0f);
+		// Hashes of the items we got stuck on, perception leaves them out so we don't go for them again
+	m_Blackboard->AddData("UnreachableItems", new std::vector<int>{});
+		// First element is the total time spent going for items and the second is the amount of items we grabbed
+	m_Blackboard->AddData("GrabStatistics", new std::pair<float, int>{ 0.0f, 0 });
+		// If we picked up or destroyed the target item yet
+	m_Blackboard->AddData("TargetItemHandled", false);
 
 	// Inventory Management
-		// Our inventory itself
-	m_Blackboard->AddData("Inventory", new std::vector<ItemInfo>
-		{
-			ItemInfo{ eItemType::GARBAGE },
-			ItemInfo{ eItemType::GARBAGE },
-			ItemInfo{ eItemType::GARBAGE },
-			ItemInfo{ eItemType::GARBAGE },
-			ItemInfo{ eItemType::GARBAGE }
-		}
-	);
+		// Our inventory itself, every change to it goes through here so it stays in sync with the game
+	m_Blackboard->AddData("Inventory", new Memory::Inventory{ m_Interface });
+		// Decides which item to swap out for a better one once the inventory is full
+	m_Blackboard->AddData("InventoryOptimizer", new DecisionMaking::InventoryOptimizer{});
 		// The distance where we won't shoot anymore with a shotgun
 	m_Blackboard->AddData("MaximumShotgunDistance", 5.0f);
 		// The angle that is to wide for a shotgun
@@ -307,29 +442,168 @@ void SurvivalAgentPlugin::CreateBlackboard()
 	m_Blackboard->AddData("MaximumPistolDistance", 7.0f);
 		// The angle that is to wide for a pistol
 	m_Blackboard->AddData("MaximumPistolAngle", 10.0f);
+		// Picks who to shoot and leads them by how far they move while we turn
+	m_Blackboard->AddData("TargetSelector", new DecisionMaking::TargetSelector{});
+		// Turns us towards whatever the behaviour tree wants to aim at
+	m_Blackboard->AddData("AimController", new MovementBehavior::AimController{});
 }
 
 void SurvivalAgentPlugin::UpdateBlackboard(float deltaTime)
 {
-	// Mark all explored houses as unexplored again when there is a new wave
-	StatisticsInfo stats{ m_Interface->World_GetStats() };
+	// Take this tick's snapshot of everything we perceive, the rest of the tick reads from it
+	PerceptionFrame* perception{};
+	m_Blackboard->GetData("Perception", perception);
+	perception->Build(m_Interface);
+
+	// Mark all explored houses as unexplored again and roam the whole world again when there is a new wave
+	// Zombies, purge zones and the items we remember are still there, so those memories stay
+	const StatisticsInfo& stats{ perception->Stats };
 	if (stats.Difficulty > m_CurrentDifficultyLevel)
 	{
 		m_CurrentDifficultyLevel = stats.Difficulty;
 
-		std::unordered_map<HouseInfo, std::tuple<bool, Elite::Vector2, std::unordered_set<ItemInfo>>>* foundHouses{};
-		m_Blackboard->GetData("FoundHouses", foundHouses);
-		std::ranges::for_each(*foundHouses, [](auto& element) -> void 
-			{
-				std::get<0>(element.second) = false;
-			});
+		Memory::HouseRegistry* houseRegistry{};
+		m_Blackboard->GetData("HouseRegistry", houseRegistry);
+		houseRegistry->ResetExplored();
+
+		Memory::CoverageMap* coverageMap{};
+		m_Blackboard->GetData("CoverageMap", coverageMap);
+		coverageMap->Clear();
+		std::pair<float, float>* coverageStatistics{};
+		m_Blackboard->GetData("CoverageStatistics", coverageStatistics);
+		coverageStatistics->second = 0.0f;
+		std::pair<bool, Elite::Vector2>* roamTarget{};
+		m_Blackboard->GetData("RoamTarget", roamTarget);
+		roamTarget->first = false;
 	}
 
 	m_Blackboard->ChangeData("StatisticsInfo", stats);
-	m_Blackboard->ChangeData("Houses", m_Interface->GetHousesInFOV());
-	m_Blackboard->ChangeData("Enemies", m_Interface->GetEnemiesInFOV());
-	m_Blackboard->ChangeData("PurgeZones", m_Interface->GetPurgeZonesInFOV());
-	m_Blackboard->ChangeData("Items", m_Interface->GetItemsInFOV());
-	m_Blackboard->ChangeData("FOVStats", m_Interface->FOV_GetStats());
-	m_Blackboard->ChangeData("AgentInfo", m_Interface->Agent_GetInfo());
+	const HousesInFOV& houses{ perception->Houses };
+	const EnemiesInFOV& enemies{ perception->Enemies };
+	const PurgeZonesInFOV& zones{ perception->PurgeZones };
+	const ItemsInFOV& items{ perception->Items };
+	const std::array<size_t, 4> seen{ houses.size() + houses.GetDropped(), enemies.size() + enemies.GetDropped(), zones.size() + zones.GetDropped(), items.size() + items.GetDropped() };
+	std::ranges::transform(m_LargestInFOV, seen, m_LargestInFOV.begin(), [](size_t largest, size_t count) -> size_t { return std::max(largest, count); });
+	const std::array<size_t, 4> dropped{ houses.GetDropped(), enemies.GetDropped(), zones.GetDropped(), items.GetDropped() };
+	std::ranges::transform(m_DroppedInFOV, dropped, m_DroppedInFOV.begin(), std::plus<size_t>{});
+
+	// Items we got stuck on are left out after counting them, nothing further down should go for them again
+	std::vector<int>* unreachableItems{};
+	m_Blackboard->GetData("UnreachableItems", unreachableItems);
+	perception->IgnoreItems(*unreachableItems);
+
+	m_Blackboard->ChangeData("FOVStats", perception->FOV);
+	AgentInfo agentInfo{};
+	m_Blackboard->GetData("AgentInfo", agentInfo);
+	const AgentInfo& newAgentInfo{ perception->Agent };
+	m_Blackboard->ChangeData("AgentInfo", newAgentInfo);
+
+	// Keep track of how far we walked, the first frame we still have a default position
+	std::pair<float, int>* travelStatistics{};
+	m_Blackboard->GetData("TravelStatistics", travelStatistics);
+	if (agentInfo.Position != Elite::Vector2{}) travelStatistics->first += agentInfo.Position.Distance(newAgentInfo.Position);
+
+	Memory::ItemMemory* itemMemory{};
+	m_Blackboard->GetData("ItemMemory", itemMemory);
+	itemMemory->Observe(newAgentInfo, items);
+
+	// The tour holds every unexplored house we know, explored ones leave it and a new wave brings them all back
+	Memory::HouseRegistry* houseRegistry{};
+	m_Blackboard->GetData("HouseRegistry", houseRegistry);
+	Navigation::TourOptimizer* tourOptimizer{};
+	m_Blackboard->GetData("TourOptimizer", tourOptimizer);
+	tourOptimizer->SetStart(newAgentInfo.Position);
+	for (int id{}; id < houseRegistry->GetCount(); ++id)
+	{
+		if (houseRegistry->IsExplored(id)) tourOptimizer->RemoveStop(id);
+		else tourOptimizer->AddStop(id, houseRegistry->GetCenter(id));
+	}
+
+	// Mark what we see now as covered and report how much of the world we saw every minute
+	Memory::CoverageMap* coverageMap{};
+	m_Blackboard->GetData("CoverageMap", coverageMap);
+	coverageMap->MarkCone(newAgentInfo.Position, newAgentInfo.Orientation, newAgentInfo.FOV_Angle, newAgentInfo.FOV_Range);
+	std::pair<float, float>* coverageStatistics{};
+	m_Blackboard->GetData("CoverageStatistics", coverageStatistics);
+	coverageStatistics->first += deltaTime;
+	if (coverageStatistics->first >= 60.0f)
+	{
+		const float coverage{ coverageMap->GetCoverage() };
+		std::cout << "Coverage: " << (coverage * 100.0f) << "% of the world, " << ((coverage - coverageStatistics->second) * 100.0f) << "% in the last minute" << std::endl;
+		coverageStatistics->first -= 60.0f;
+		coverageStatistics->second = coverage;
+	}
+
+	Memory::EnemyTracker* enemyTracker{};
+	m_Blackboard->GetData("EnemyTracker", enemyTracker);
+	enemyTracker->Update(deltaTime, enemies);
+
+	Memory::ThreatMap* threatMap{};
+	m_Blackboard->GetData("ThreatMap", threatMap);
+	threatMap->Decay(deltaTime);
+	std::ranges::for_each(enemies, [threatMap, deltaTime](const EnemyInfo& enemy) -> void { threatMap->AddEnemy(enemy, deltaTime); });
+
+	// Every enemy we see is a neighbour to keep away from
+	MovementBehavior::Separation* separation{};
+	m_Blackboard->GetData("Separation", separation);
+	separation->ClearNeighbours();
+	std::ranges::for_each(enemies, [separation](const EnemyInfo& enemy) -> void { separation->AddNeighbour(enemy.Location, enemy.Size); });
+
+	// Let the danger of old sightings fade out, then add the houses and zombies we see now
+	Navigation::NavigationGrid* grid{};
+	m_Blackboard->GetData("NavigationGrid", grid);
+	grid->DecayDanger(deltaTime);
+	Navigation::PathSmoother* pathSmoother{};
+	m_Blackboard->GetData("PathSmoother", pathSmoother);
+	std::ranges::for_each(houses, [grid, pathSmoother](const HouseInfo& house) -> void
+		{
+			grid->AddHouse(house.Center, house.Size);
+			pathSmoother->AddObstacle(house.Center, house.Size);
+		});
+	std::ranges::for_each(enemies, [grid](const EnemyInfo& enemy) -> void { grid->AddDanger(enemy.Location, 4.0f); });
+
+	// Remembered purge zones keep paths and the flow field away from them until they should have ended
+	Memory::ZoneRegistry* zoneRegistry{};
+	m_Blackboard->GetData("ZoneRegistry", zoneRegistry);
+	zoneRegistry->Update(deltaTime, zones);
+	Navigation::FlowField* flowField{};
+	m_Blackboard->GetData("SafetyFlowField", flowField);
+	for (size_t zone{}; zone < zoneRegistry->GetCount(); ++zone)
+	{
+		flowField->AddPurgeZone(zoneRegistry->GetCenter(zone), zoneRegistry->GetRadius(zone), zoneRegistry->GetTimeLeft(zone));
+	}
+
+	// Zone danger doesn't decay, the grid only hears about zones when one comes or goes so the cached paths stay valid
+	if (zoneRegistry->HasChanged())
+	{
+		grid->ClearZoneDanger();
+		for (size_t zone{}; zone < zoneRegistry->GetCount(); ++zone) grid->AddZoneDanger(zoneRegistry->GetCenter(zone), zoneRegistry->GetRadius(zone), 16.0f);
+		grid->ApplyZoneDanger();
+	}
+}
+
+void SurvivalAgentPlugin::ApplyAimRequest(float deltaTime)
+{
+	MovementBehavior::AimController* aimController{};
+	m_Blackboard->GetData("AimController", aimController);
+	if (!aimController->HasRequest()) return;
+
+	// Fleeing already looks at the closest enemy, turning us somewhere else would only slow down the escape, we still fire when it lines up
+	if (m_ExplorationFiniteStateMachine->AtState(m_Escape))
+	{
+		aimController->ClearRequest();
+		return;
+	}
+
+	AgentInfo agentInfo{};
+	m_Blackboard->GetData("AgentInfo", agentInfo);
+
+	SteeringPlugin_Output* steering{};
+	m_Blackboard->GetData("SteeringOutput", steering);
+
+	// Requests only last for the tick they were made in
+	const SteeringPlugin_Output aimOutput{ aimController->CalculateSteering(deltaTime, agentInfo, aimController->GetRequest()) };
+	steering->AngularVelocity = aimOutput.AngularVelocity;
+	steering->AutoOrient = aimOutput.AutoOrient;
+	aimController->ClearRequest();
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "IExamPlugin.h"
 #include "Exam_HelperStructs.h"
+#include <array>
 
 class IBaseInterface;
 class IExamInterface;
@@ -53,6 +54,20 @@ class SurvivalAgentPlugin final : public IExamPlugin
 		DecisionMaking::FiniteStateMachine::StateMachine* m_ExplorationFiniteStateMachine;
 		DecisionMaking::BehaviourTree::Tree* m_InventoryBehaviourTree;	
 		float m_CurrentDifficultyLevel;
+		// The most houses, enemies, purge zones and items we saw at once, logged with the tick time to check the perception capacities
+		std::array<size_t, 4> m_LargestInFOV{};
+		// The houses, enemies, purge zones and items that didn't fit since the last tick time report, reported with it
+		std::array<size_t, 4> m_DroppedInFOV{};
+		// Seed for the game and for our own random behaviours so runs can be replayed
+		const int m_Seed{ 4 };
+		// Microseconds the safety flow field may spend on recalculating dirty cells each frame
+		const long long m_FlowFieldBudget{ 500 };
+		// Microseconds the path scheduler may spend on path requests each frame
+		const long long m_PathBudget{ 1000 };
+		// Microseconds the house tour optimizer may spend on improving the tour each frame
+		const long long m_TourBudget{ 200 };
+		// Turn off to compare the distance travelled with the raw nav mesh points
+		const bool m_UsePathSmoothing{ true };
 
 		// Exploration States, also stored here for rendering purposes (also stored in the blackboard)
 		DecisionMaking::FiniteStateMachine::IState* m_Roam;
@@ -70,6 +85,8 @@ class SurvivalAgentPlugin final : public IExamPlugin
 
 		void CreateBlackboard();
 		void UpdateBlackboard(float deltaTime);
+		// Turns us towards what the behaviour tree asked to aim at this tick, on top of what the states steer, except while escaping
+		void ApplyAimRequest(float deltaTime);
 };
 
 extern "C"
@@ -0,0 +1,233 @@
+#include "stdafx.h"
+#include "Sweep Planner.h"
+
+namespace Navigation
+{
+	SweepPlanner::SweepPlanner(float cellSize, float wallDistance, size_t maximumViewpoints, float viewpointCost, float coverage) :
+		m_CellSize{ cellSize },
+		m_WallDistance{ wallDistance },
+		m_MaximumViewpoints{ maximumViewpoints },
+		m_ViewpointCost{ viewpointCost },
+		m_Coverage{ coverage },
+		m_Cells{},
+		m_Seen{},
+		m_Candidates{}
+	{
+
+	}
+
+	void SweepPlanner::Plan(const Elite::Vector2& center, const Elite::Vector2& size, const AgentInfo& agentInfo, std::vector<Elite::Vector2>& viewpoints)
+	{
+		viewpoints.clear();
+		m_Cells.clear();
+		m_Candidates.clear();
+
+		const Elite::Vector2 minimum{ center - (size / 2.0f) };
+		const int columns{ std::max(int(size.x / m_CellSize), 1) };
+		const int rows{ std::max(int(size.y / m_CellSize), 1) };
+		const Elite::Vector2 cellSize{ size.x / float(columns), size.y / float(rows) };
+		// Cells cover the whole inside, we can only stand a bit away from the walls and in big houses every other cell is close enough as a place to stand
+		const int candidateStep{ ((columns * rows) > 100) ? 2 : 1 };
+		for (int row{}; row < rows; ++row)
+		{
+			for (int column{}; column < columns; ++column)
+			{
+				const Elite::Vector2 cell{ minimum.x + ((float(column) + 0.5f) * cellSize.x), minimum.y + ((float(row) + 0.5f) * cellSize.y) };
+				m_Cells.push_back(cell);
+
+				const Elite::Vector2 offset{ (cell - center).GetAbs() };
+				const bool awayFromWalls{ (offset.x <= (size.x / 2.0f) - m_WallDistance) && (offset.y <= (size.y / 2.0f) - m_WallDistance) };
+				if (awayFromWalls && ((row % candidateStep) == 0) && ((column % candidateStep) == 0)) m_Candidates.push_back(cell);
+			}
+		}
+		if (m_Candidates.empty()) m_Candidates.push_back(center);
+
+		// Stay a bit inside the field of view, items right on its edge are easily missed
+		const float range{ agentInfo.FOV_Range * 0.9f };
+		const float halfAngle{ agentInfo.FOV_Angle * 0.45f };
+		const float cosine{ cosf(halfAngle) };
+		const int requiredCells{ int(ceilf(float(m_Cells.size()) * m_Coverage)) };
+
+		std::vector<Elite::Vector2> greedyViewpoints{};
+		PlanGreedy(agentInfo, range, cosine, requiredCells, greedyViewpoints);
+		Prune(agentInfo, range, cosine, requiredCells, greedyViewpoints);
+		const int greedySeenCells{ Simulate(agentInfo, greedyViewpoints, range, cosine) };
+
+		std::vector<Elite::Vector2> laneViewpoints{};
+		PlanLanes(center, size, agentInfo, range, halfAngle, laneViewpoints);
+		Prune(agentInfo, range, cosine, requiredCells, laneViewpoints);
+		PlanGreedy(agentInfo, range, cosine, requiredCells, laneViewpoints);
+		const int laneSeenCells{ Simulate(agentInfo, laneViewpoints, range, cosine) };
+
+		// The cheapest plan wins, every cell it leaves unseen costs as much as an extra viewpoint
+		const float greedyCost{ GetCost(agentInfo, greedyViewpoints) + (m_ViewpointCost * float(std::max(requiredCells - greedySeenCells, 0))) };
+		const float laneCost{ GetCost(agentInfo, laneViewpoints) + (m_ViewpointCost * float(std::max(requiredCells - laneSeenCells, 0))) };
+		viewpoints = (laneCost < greedyCost) ? laneViewpoints : greedyViewpoints;
+
+		// We always walk in at least a bit
+		if (viewpoints.empty()) viewpoints.push_back(*std::ranges::min_element(m_Candidates, {}, [&agentInfo](const Elite::Vector2& candidate) -> float { return candidate.DistanceSquared(agentInfo.Position); }));
+	}
+
+	void SweepPlanner::PlanGreedy(const AgentInfo& agentInfo, float range, float cosine, int requiredCells, std::vector<Elite::Vector2>& viewpoints)
+	{
+		// Carries on from the viewpoints already planned, that way it also patches up the holes the lanes leave
+		int seenCells{ Simulate(agentInfo, viewpoints, range, cosine) };
+
+		// Greedy set cover, always walk to the viewpoint that shows the most new cells per distance walked
+		Elite::Vector2 position{ viewpoints.empty() ? agentInfo.Position : viewpoints.back() };
+		while ((seenCells < requiredCells) && (viewpoints.size() < m_MaximumViewpoints))
+		{
+			const Elite::Vector2* pBestCandidate{};
+			float bestScore{};
+			for (const Elite::Vector2& candidate : m_Candidates)
+			{
+				const float distance{ position.Distance(candidate) };
+				if (distance < m_CellSize) continue;
+
+				const float score{ float(Walk(position, candidate, range, cosine, false)) / (distance + m_ViewpointCost) };
+				if (score > bestScore)
+				{
+					bestScore = score;
+					pBestCandidate = &candidate;
+				}
+			}
+
+			if (pBestCandidate == nullptr) break;
+
+			seenCells += Walk(position, *pBestCandidate, range, cosine, true);
+			position = *pBestCandidate;
+			viewpoints.push_back(position);
+		}
+	}
+
+	void SweepPlanner::PlanLanes(const Elite::Vector2& center, const Elite::Vector2& size, const AgentInfo& agentInfo, float range, float halfAngle, std::vector<Elite::Vector2>& viewpoints) const
+	{
+		// Lanes along the long side of the house, walking one shows a strip as wide as our view reaches sideways
+		const bool alongX{ size.x >= size.y };
+		const float length{ std::max((alongX ? size.x : size.y) / 2.0f - m_WallDistance, 0.0f) };
+		const float width{ alongX ? size.y : size.x };
+		const float reach{ std::max(range * sinf(std::min(halfAngle, float(E_PI) / 2.0f)), m_CellSize) };
+		const int laneCount{ std::max(int(ceilf(width / (2.0f * reach))), 1) };
+
+		std::vector<Elite::Vector2> lanePoints{};
+		for (int lane{}; lane < laneCount; ++lane)
+		{
+			const float side{ std::clamp((-width / 2.0f) + (width * (float(lane) + 0.5f) / float(laneCount)), -width / 2.0f + m_WallDistance, width / 2.0f - m_WallDistance) };
+			const float along{ ((lane % 2) == 0) ? -length : length };
+			lanePoints.push_back(center + (alongX ? Elite::Vector2{ along, side } : Elite::Vector2{ side, along }));
+			lanePoints.push_back(center + (alongX ? Elite::Vector2{ -along, side } : Elite::Vector2{ side, -along }));
+		}
+
+		// Start at whichever end of the zigzag is closest to us, walking it backwards if needed
+		const Elite::Vector2 mirror{ alongX ? Elite::Vector2{ -1.0f, 1.0f } : Elite::Vector2{ 1.0f, -1.0f } };
+		viewpoints.clear();
+		float closestDistance{ FLT_MAX };
+		for (int variant{}; variant < 4; ++variant)
+		{
+			std::vector<Elite::Vector2> points{ lanePoints };
+			if ((variant & 1) != 0) std::ranges::for_each(points, [&center, &mirror](Elite::Vector2& point) -> void { point = center + ((point - center) * mirror); });
+			if ((variant & 2) != 0) std::ranges::reverse(points);
+
+			const float distance{ agentInfo.Position.DistanceSquared(points.front()) };
+			if (distance < closestDistance)
+			{
+				closestDistance = distance;
+				viewpoints = points;
+			}
+		}
+	}
+
+	void SweepPlanner::Prune(const AgentInfo& agentInfo, float range, float cosine, int requiredCells, std::vector<Elite::Vector2>& viewpoints)
+	{
+		// Drop every viewpoint we can do without, what we see on the way to the next one might be enough
+		for (size_t viewpoint{}; viewpoint < viewpoints.size();)
+		{
+			if (viewpoints.size() == 1) return;
+
+			const Elite::Vector2 removed{ viewpoints[viewpoint] };
+			viewpoints.erase(std::begin(viewpoints) + viewpoint);
+			if (Simulate(agentInfo, viewpoints, range, cosine) >= requiredCells) continue;
+
+			viewpoints.insert(std::begin(viewpoints) + viewpoint, removed);
+			++viewpoint;
+		}
+	}
+
+	float SweepPlanner::GetCost(const AgentInfo& agentInfo, const std::vector<Elite::Vector2>& viewpoints) const
+	{
+		float cost{ m_ViewpointCost * float(viewpoints.size()) };
+		Elite::Vector2 position{ agentInfo.Position };
+		std::ranges::for_each(viewpoints, [&cost, &position](const Elite::Vector2& viewpoint) -> void
+			{
+				cost += position.Distance(viewpoint);
+				position = viewpoint;
+			});
+
+		return cost;
+	}
+
+	int SweepPlanner::Simulate(const AgentInfo& agentInfo, const std::vector<Elite::Vector2>& viewpoints, float range, float cosine)
+	{
+		m_Seen.assign(m_Cells.size(), false);
+		int seenCells{ Look(agentInfo.Position, Elite::OrientationToVector(agentInfo.Orientation), range, cosine, true) };
+
+		Elite::Vector2 position{ agentInfo.Position };
+		for (const Elite::Vector2& viewpoint : viewpoints)
+		{
+			if (position.DistanceSquared(viewpoint) > 0.0f) seenCells += Walk(position, viewpoint, range, cosine, true);
+			position = viewpoint;
+		}
+
+		return seenCells;
+	}
+
+	int SweepPlanner::Walk(const Elite::Vector2& from, const Elite::Vector2& to, float range, float cosine, bool mark)
+	{
+		const Elite::Vector2 direction{ (to - from).GetNormalized() };
+		const float distance{ from.Distance(to) };
+		const int steps{ std::max(int(ceilf(distance / m_CellSize)), 1) };
+
+		// A cell counts once, no matter from how many points on the way we would see it
+		int newCells{};
+		for (size_t cell{}; cell < m_Cells.size(); ++cell)
+		{
+			if (m_Seen[cell]) continue;
+
+			// Cells further than our view range from the whole segment can't be seen from any point on it
+			const Elite::Vector2 toCell{ m_Cells[cell] - from };
+			const Elite::Vector2 closest{ from + (direction * std::clamp(toCell.Dot(direction), 0.0f, distance)) };
+			if (closest.DistanceSquared(m_Cells[cell]) > (range * range)) continue;
+
+			for (int step{ 1 }; step <= steps; ++step)
+			{
+				const Elite::Vector2 offset{ m_Cells[cell] - (from + (direction * (distance * float(step) / float(steps)))) };
+				const float cellDistance{ offset.Magnitude() };
+				if ((cellDistance <= range) && (offset.Dot(direction) >= (cosine * cellDistance)))
+				{
+					++newCells;
+					if (mark) m_Seen[cell] = true;
+					break;
+				}
+			}
+		}
+
+		return newCells;
+	}
+
+	int SweepPlanner::Look(const Elite::Vector2& position, const Elite::Vector2& direction, float range, float cosine, bool mark)
+	{
+		int newCells{};
+		for (size_t cell{}; cell < m_Cells.size(); ++cell)
+		{
+			const Elite::Vector2 offset{ m_Cells[cell] - position };
+			const float cellDistance{ offset.Magnitude() };
+			if (!m_Seen[cell] && (cellDistance <= range) && (offset.Dot(direction) >= (cosine * cellDistance)))
+			{
+				++newCells;
+				if (mark) m_Seen[cell] = true;
+			}
+		}
+
+		return newCells;
+	}
+}
\ No newline at end of file
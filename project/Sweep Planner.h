@@ -0,0 +1,50 @@
+#ifndef SWEEP_PLANNER
+#define SWEEP_PLANNER
+
+#include "Exam_HelperStructs.h"
+#include <vector>
+
+namespace Navigation
+{
+	// Picks the few points inside a house to walk past so our field of view has covered the whole inside
+	class SweepPlanner final
+	{
+	public:
+		// Every viewpoint costs as much as walking the viewpoint cost further, so a few long walks win over many short ones
+		SweepPlanner(float cellSize = 2.0f, float wallDistance = 2.5f, size_t maximumViewpoints = 12, float viewpointCost = 3.0f, float coverage = 0.98f);
+		~SweepPlanner() = default;
+
+		SweepPlanner(const SweepPlanner&) = delete;
+		SweepPlanner& operator=(const SweepPlanner&) = delete;
+		SweepPlanner(SweepPlanner&&) = delete;
+		SweepPlanner& operator=(SweepPlanner&&) = delete;
+
+		// Viewpoints in the order to walk them starting from where the agent is, what it sees right now already counts
+		void Plan(const Elite::Vector2& center, const Elite::Vector2& size, const AgentInfo& agentInfo, std::vector<Elite::Vector2>& viewpoints);
+
+	private:
+		float m_CellSize;
+		float m_WallDistance;
+		size_t m_MaximumViewpoints;
+		float m_ViewpointCost;
+		float m_Coverage;
+
+		// The centers of the cells inside the house that have to be seen, if they are and where we could stand
+		std::vector<Elite::Vector2> m_Cells;
+		std::vector<bool> m_Seen;
+		std::vector<Elite::Vector2> m_Candidates;
+
+		// Two ways to sweep, the cheapest one that sees enough of the house wins
+		void PlanGreedy(const AgentInfo& agentInfo, float range, float cosine, int requiredCells, std::vector<Elite::Vector2>& viewpoints);
+		void PlanLanes(const Elite::Vector2& center, const Elite::Vector2& size, const AgentInfo& agentInfo, float range, float halfAngle, std::vector<Elite::Vector2>& viewpoints) const;
+		void Prune(const AgentInfo& agentInfo, float range, float cosine, int requiredCells, std::vector<Elite::Vector2>& viewpoints);
+		float GetCost(const AgentInfo& agentInfo, const std::vector<Elite::Vector2>& viewpoints) const;
+
+		// Cells we haven't seen yet that come into view when walking the segment while looking where we go
+		int Simulate(const AgentInfo& agentInfo, const std::vector<Elite::Vector2>& viewpoints, float range, float cosine);
+		int Walk(const Elite::Vector2& from, const Elite::Vector2& to, float range, float cosine, bool mark);
+		int Look(const Elite::Vector2& position, const Elite::Vector2& direction, float range, float cosine, bool mark);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "stdafx.h"
+#include "Target Selector.h"
+#include <array>
+#include <algorithm>
+
+namespace DecisionMaking
+{
+	TargetSelector::TargetSelector(float reactionTime) :
+		m_ReactionTime{ reactionTime }
+	{
+
+	}
+
+	bool TargetSelector::FindPistolTarget(const AgentInfo& agentInfo, std::span<const EnemyInfo> enemies, float range, float maximumAngle, Solution& solution) const
+	{
+		Solution bestSolution{};
+		float bestTime{ FLT_MAX };
+		const size_t enemyCount{ std::min(enemies.size(), MaximumEnemies) };
+		for (size_t index{}; index < enemyCount; ++index)
+		{
+			const EnemyInfo& enemy{ enemies[index] };
+			if (enemy.Health <= 0.0f) continue;
+
+			Elite::Vector2 relativePosition{};
+			float angle{};
+			const float time{ Predict(agentInfo, enemy, relativePosition, angle) };
+			// We might fire before we are done turning, so it has to be in range now as well as then
+			const float distance{ relativePosition.Magnitude() };
+			if ((std::max(distance, enemy.Location.Distance(agentInfo.Position)) >= range) || (time >= bestTime)) continue;
+
+			// The bullet hits when it passes through the enemy's body
+			const float tolerance{ std::min(std::asin(std::min(enemy.Size / std::max(distance, FLT_MIN), 1.0f)), maximumAngle) };
+
+			bestTime = time;
+			bestSolution = Solution{ int(index), agentInfo.Position + relativePosition, angle, tolerance, 1 };
+		}
+
+		if (bestSolution.target == InvalidTarget) return false;
+
+		solution = bestSolution;
+		return true;
+	}
+
+	bool TargetSelector::FindShotgunTarget(const AgentInfo& agentInfo, std::span<const EnemyInfo> enemies, float range, float halfAngle, Solution& solution) const
+	{
+		// Work out where everyone is and how fast they move relative to us once, every aim is tried against all of them
+		std::array<Elite::Vector2, MaximumEnemies> relativePositions{};
+		std::array<Elite::Vector2, MaximumEnemies> relativeVelocities{};
+		std::array<float, MaximumEnemies> times{};
+		std::array<float, MaximumEnemies> angles{};
+		std::array<bool, MaximumEnemies> usable{};
+		const size_t enemyCount{ std::min(enemies.size(), MaximumEnemies) };
+		for (size_t index{}; index < enemyCount; ++index)
+		{
+			relativeVelocities[index] = enemies[index].LinearVelocity - agentInfo.LinearVelocity;
+			times[index] = Predict(agentInfo, enemies[index], relativePositions[index], angles[index]);
+
+			// We might fire before we are done turning, so it has to be in range now as well as then
+			usable[index] = (enemies[index].Health > 0.0f) && (enemies[index].Location.Distance(agentInfo.Position) < range);
+		}
+
+		Solution bestSolution{};
+		float bestTime{ FLT_MAX };
+		for (size_t aim{}; aim < enemyCount; ++aim)
+		{
+			if (!usable[aim] || (relativePositions[aim].Magnitude() >= range)) continue;
+
+			// Everyone else moves along for as long as we take to face this one
+			int hits{};
+			float largestOffset{};
+			for (size_t other{}; other < enemyCount; ++other)
+			{
+				if (!usable[other]) continue;
+
+				const Elite::Vector2 otherPosition{ relativePositions[other] + relativeVelocities[other] * (times[aim] - times[other]) };
+				if (otherPosition.Magnitude() >= range) continue;
+
+				const float offset{ std::abs(Elite::AngleBetween(relativePositions[aim], otherPosition)) };
+				if (offset >= halfAngle) continue;
+
+				++hits;
+				largestOffset = std::max(largestOffset, offset);
+			}
+
+			if ((hits < bestSolution.expectedHits) || ((hits == bestSolution.expectedHits) && (times[aim] >= bestTime))) continue;
+
+			bestTime = times[aim];
+			bestSolution = Solution{ int(aim), agentInfo.Position + relativePositions[aim], angles[aim], halfAngle - largestOffset, hits };
+		}
+
+		if (bestSolution.target == InvalidTarget) return false;
+
+		solution = bestSolution;
+		return true;
+	}
+
+	bool TargetSelector::IsAligned(const Solution& solution) const
+	{
+		return (solution.target != InvalidTarget) && (std::abs(solution.turnAngle) <= solution.tolerance);
+	}
+
+	float TargetSelector::Predict(const AgentInfo& agentInfo, const EnemyInfo& enemy, Elite::Vector2& relativePosition, float& angle) const
+	{
+		const Elite::Vector2 forward{ Elite::OrientationToVector(agentInfo.Orientation) };
+		const Elite::Vector2 relativeVelocity{ enemy.LinearVelocity - agentInfo.LinearVelocity };
+		const float maximumAngularSpeed{ std::max(agentInfo.MaxAngularSpeed, FLT_MIN) };
+
+		// Turning takes longer the further the enemy moved, a few rounds settle on where we meet it
+		float time{ m_ReactionTime };
+		for (int iteration{}; iteration < 3; ++iteration)
+		{
+			relativePosition = (enemy.Location - agentInfo.Position) + relativeVelocity * time;
+			angle = Elite::AngleBetween(forward, relativePosition);
+			time = m_ReactionTime + (std::abs(angle) / maximumAngularSpeed);
+		}
+
+		relativePosition = (enemy.Location - agentInfo.Position) + relativeVelocity * time;
+		angle = Elite::AngleBetween(forward, relativePosition);
+		return time;
+	}
+}
\ No newline at end of file
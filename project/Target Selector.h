@@ -0,0 +1,54 @@
+#ifndef TARGET_SELECTOR
+#define TARGET_SELECTOR
+
+#include "Exam_HelperStructs.h"
+#include "Perception.h"
+#include <span>
+
+namespace DecisionMaking
+{
+	// Picks who to shoot and where to aim, leading the enemies by how far they move while we turn towards them
+	// Turning itself is up to the aim controller
+	class TargetSelector final
+	{
+	public:
+		static constexpr int InvalidTarget{ -1 };
+		// Enemies past this many are ignored, the perception frame never holds more
+		static constexpr size_t MaximumEnemies{ EnemiesInFOV::GetCapacity() };
+
+		struct Solution final
+		{
+			// Index in the enemies we were given, InvalidTarget if there is nobody to shoot
+			int target{ InvalidTarget };
+			Elite::Vector2 aimPoint{};
+			// How far we still have to turn (radians, positive is counter clockwise) and how far off we may be and still hit
+			float turnAngle{};
+			float tolerance{};
+			int expectedHits{};
+		};
+
+		// The reaction time is how long after deciding the shot actually goes off
+		TargetSelector(float reactionTime = 0.0f);
+		~TargetSelector() = default;
+
+		TargetSelector(const TargetSelector&) = delete;
+		TargetSelector& operator=(const TargetSelector&) = delete;
+		TargetSelector(TargetSelector&&) = delete;
+		TargetSelector& operator=(TargetSelector&&) = delete;
+
+		// One hit at best, the enemy in range we can face the quickest
+		bool FindPistolTarget(const AgentInfo& agentInfo, std::span<const EnemyInfo> enemies, float range, float maximumAngle, Solution& solution) const;
+		// The aim that gets the most enemies inside the cone (half angle in radians), the quickest one to face on a tie
+		bool FindShotgunTarget(const AgentInfo& agentInfo, std::span<const EnemyInfo> enemies, float range, float halfAngle, Solution& solution) const;
+
+		bool IsAligned(const Solution& solution) const;
+
+	private:
+		float m_ReactionTime;
+
+		// Where the enemy will be relative to us by the time we face it, returns the time that takes
+		float Predict(const AgentInfo& agentInfo, const EnemyInfo& enemy, Elite::Vector2& relativePosition, float& angle) const;
+	};
+}
+
+#endif
\ No newline at end of file
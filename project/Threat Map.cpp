@@ -0,0 +1,150 @@
+#include "stdafx.h"
+#include "Threat Map.h"
+#include "Zone Registry.h"
+#include <xmmintrin.h>
+
+namespace Memory
+{
+	namespace
+	{
+		// Runners catch up with us and heavies hit harder, both are worse than a normal zombie
+		float GetEnemyWeight(eEnemyType type)
+		{
+			switch (type)
+			{
+			case eEnemyType::ZOMBIE_RUNNER:
+				return 2.0f;
+			case eEnemyType::ZOMBIE_HEAVY:
+				return 2.5f;
+			default:
+				return 1.0f;
+			}
+		}
+	}
+
+	ThreatMap::ThreatMap(const WorldInfo& worldInfo, float cellSize, float halfLife, float splatRadius) :
+		m_Origin{ worldInfo.Center - (worldInfo.Dimensions / 2.0f) },
+		m_Dimensions{ worldInfo.Dimensions },
+		m_CellSize{ cellSize },
+		m_HalfLife{ halfLife },
+		m_SplatRadius{ splatRadius },
+		m_Columns{ std::max(int(ceilf(worldInfo.Dimensions.x / cellSize)), 1) },
+		m_Rows{ std::max(int(ceilf(worldInfo.Dimensions.y / cellSize)), 1) },
+		m_Scale{ 1.0f },
+		m_Threats(size_t(m_Columns * m_Rows), 0.0f)
+	{
+
+	}
+
+	void ThreatMap::Decay(float deltaTime)
+	{
+		m_Scale *= powf(0.5f, deltaTime / m_HalfLife);
+		if (m_Scale < MinimumScale) Rescale();
+	}
+
+	void ThreatMap::AddEnemy(const EnemyInfo& enemy, float deltaTime)
+	{
+		AddThreat(enemy.Location, GetEnemyWeight(enemy.Type), deltaTime);
+	}
+
+	void ThreatMap::AddThreat(const Elite::Vector2& position, float threatPerSecond, float deltaTime)
+	{
+		// Stored values get divided by the scale so they come out right when we multiply again
+		const float storedThreat{ (threatPerSecond * deltaTime) / m_Scale };
+
+		// Linear falloff from the position to the splat radius
+		for (int row{ GetRow(position.y - m_SplatRadius) }; row <= GetRow(position.y + m_SplatRadius); ++row)
+		{
+			for (int column{ GetColumn(position.x - m_SplatRadius) }; column <= GetColumn(position.x + m_SplatRadius); ++column)
+			{
+				const Elite::Vector2 cellCenter{ m_Origin.x + ((float(column) + 0.5f) * m_CellSize), m_Origin.y + ((float(row) + 0.5f) * m_CellSize) };
+				const float falloff{ 1.0f - (cellCenter.Distance(position) / m_SplatRadius) };
+				if (falloff > 0.0f) m_Threats[size_t((row * m_Columns) + column)] += storedThreat * falloff;
+			}
+		}
+	}
+
+	float ThreatMap::GetThreat(const Elite::Vector2& position) const
+	{
+		if (!IsInside(position)) return 0.0f;
+
+		return m_Threats[size_t((GetRow(position.y) * m_Columns) + GetColumn(position.x))] * m_Scale;
+	}
+
+	bool ThreatMap::IsDangerous(const Elite::Vector2& position) const
+	{
+		return GetThreat(position) > DangerousThreat;
+	}
+
+	bool ThreatMap::IsInside(const Elite::Vector2& position) const
+	{
+		const Elite::Vector2 local{ position - m_Origin };
+		return (local.x >= 0.0f) && (local.y >= 0.0f) && (local.x <= m_Dimensions.x) && (local.y <= m_Dimensions.y);
+	}
+
+	Elite::Vector2 ThreatMap::FindSafestPoint(const Elite::Vector2& center, float radius, const Elite::Vector2& preferred, const ZoneRegistry* pZoneRegistry, int sampleCount) const
+	{
+		Elite::Vector2 safestPoint{ preferred };
+		float lowestScore{ FLT_MAX };
+
+		for (int sample{}; sample < sampleCount; ++sample)
+		{
+			const float angle{ (float(sample) / float(sampleCount)) * 2.0f * float(E_PI) };
+			const Elite::Vector2 point{ center + (Elite::OrientationToVector(angle) * radius) };
+			if (!IsInside(point) || ((pZoneRegistry != nullptr) && pZoneRegistry->ContainsPoint(point, 5.0f))) continue;
+
+			// Going the opposite way costs the detour threat, less the closer we stay to the preferred point
+			const float score{ GetThreat(point) + (DetourThreat * (point.Distance(preferred) / (2.0f * radius))) };
+			if (score < lowestScore)
+			{
+				lowestScore = score;
+				safestPoint = point;
+			}
+		}
+
+		return safestPoint;
+	}
+
+	int ThreatMap::GetColumns() const
+	{
+		return m_Columns;
+	}
+
+	int ThreatMap::GetRows() const
+	{
+		return m_Rows;
+	}
+
+	void ThreatMap::Rescale()
+	{
+		// Four cells at a time, what is left of a sighting that long ago is flushed to zero
+		const __m128 scale{ _mm_set1_ps(m_Scale) };
+		const __m128 minimum{ _mm_set1_ps(0.001f) };
+		const size_t cellCount{ m_Threats.size() };
+		const size_t vectorCount{ cellCount - (cellCount % 4) };
+		float* pThreats{ m_Threats.data() };
+
+		for (size_t cell{}; cell < vectorCount; cell += 4)
+		{
+			const __m128 threats{ _mm_mul_ps(_mm_loadu_ps(pThreats + cell), scale) };
+			_mm_storeu_ps(pThreats + cell, _mm_and_ps(threats, _mm_cmpge_ps(threats, minimum)));
+		}
+		for (size_t cell{ vectorCount }; cell < cellCount; ++cell)
+		{
+			const float threat{ pThreats[cell] * m_Scale };
+			pThreats[cell] = (threat >= 0.001f) ? threat : 0.0f;
+		}
+
+		m_Scale = 1.0f;
+	}
+
+	int ThreatMap::GetColumn(float x) const
+	{
+		return std::clamp(int((x - m_Origin.x) / m_CellSize), 0, m_Columns - 1);
+	}
+
+	int ThreatMap::GetRow(float y) const
+	{
+		return std::clamp(int((y - m_Origin.y) / m_CellSize), 0, m_Rows - 1);
+	}
+}
\ No newline at end of file
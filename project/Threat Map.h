@@ -0,0 +1,65 @@
+#ifndef THREAT_MAP
+#define THREAT_MAP
+
+#include "Exam_HelperStructs.h"
+#include <vector>
+
+namespace Memory
+{
+	class ZoneRegistry;
+
+	// Heat map over the whole world of where we saw zombies, old sightings fade out exponentially
+	// Threat is in threat seconds, a normal zombie in sight for one second adds 1 where it stands (runners and heavies add more)
+	class ThreatMap final
+	{
+	public:
+		// Half a second of a normal zombie standing there makes a place dangerous
+		static constexpr float DangerousThreat{ 0.5f };
+		// Picking the point opposite the preferred one costs as much as that point being dangerous
+		static constexpr float DetourThreat{ DangerousThreat };
+
+		ThreatMap(const WorldInfo& worldInfo, float cellSize = 5.0f, float halfLife = 8.0f, float splatRadius = 15.0f);
+		~ThreatMap() = default;
+
+		ThreatMap(const ThreatMap&) = delete;
+		ThreatMap& operator=(const ThreatMap&) = delete;
+		ThreatMap(ThreatMap&&) = delete;
+		ThreatMap& operator=(ThreatMap&&) = delete;
+
+		// Decays the whole map, only a scale factor changes so this costs the same for any map size
+		void Decay(float deltaTime);
+		// Threat per second for as long as the frame lasted, so the map doesn't depend on the frame rate
+		void AddEnemy(const EnemyInfo& enemy, float deltaTime);
+		void AddThreat(const Elite::Vector2& position, float threatPerSecond, float deltaTime);
+
+		float GetThreat(const Elite::Vector2& position) const;
+		bool IsDangerous(const Elite::Vector2& position) const;
+		bool IsInside(const Elite::Vector2& position) const;
+		// Point on the circle around center with the least threat, points far from the preferred one score worse and points in zones don't count
+		Elite::Vector2 FindSafestPoint(const Elite::Vector2& center, float radius, const Elite::Vector2& preferred, const ZoneRegistry* pZoneRegistry = nullptr, int sampleCount = 16) const;
+
+		int GetColumns() const;
+		int GetRows() const;
+
+	private:
+		// Once the scale gets this small the stored values are multiplied by it and it goes back to 1
+		static constexpr float MinimumScale{ 1.0f / 65536.0f };
+
+		Elite::Vector2 m_Origin;
+		Elite::Vector2 m_Dimensions;
+		float m_CellSize;
+		float m_HalfLife;
+		float m_SplatRadius;
+		int m_Columns;
+		int m_Rows;
+		// The real threat of a cell is its stored value times the scale
+		float m_Scale;
+		std::vector<float> m_Threats;
+
+		void Rescale();
+		int GetColumn(float x) const;
+		int GetRow(float y) const;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "stdafx.h"
+#include "Tour Optimizer.h"
+#include <chrono>
+
+namespace Navigation
+{
+	namespace
+	{
+		// Moves have to win at least this much, otherwise rounding could swap two stops back and forth forever
+		constexpr float MinimumGain{ 0.001f };
+	}
+
+	TourOptimizer::TourOptimizer(float restartDistance) :
+		m_RestartDistance{ restartDistance },
+		m_Start{},
+		m_OptimizedStart{},
+		m_Ids{},
+		m_Positions{},
+		m_NextStop{ 0 },
+		m_UnimprovedStops{ 0 },
+		m_Report{ false }
+	{
+
+	}
+
+	void TourOptimizer::SetStart(const Elite::Vector2& start)
+	{
+		m_Start = start;
+		if (m_Start.DistanceSquared(m_OptimizedStart) > (m_RestartDistance * m_RestartDistance))
+		{
+			m_OptimizedStart = m_Start;
+			Restart();
+		}
+	}
+
+	void TourOptimizer::AddStop(int id, const Elite::Vector2& position)
+	{
+		if (Contains(id)) return;
+
+		// Cheapest insertion, a new house goes between the two stops it is the smallest detour for
+		const int stopCount{ int(m_Ids.size()) };
+		int bestStop{ stopCount };
+		float bestCost{ FLT_MAX };
+		for (int stop{}; stop <= stopCount; ++stop)
+		{
+			const float cost{ GetPoint(stop - 1).Distance(position) + ((stop < stopCount) ? (position.Distance(GetPoint(stop)) - GetDistance(stop - 1, stop)) : 0.0f) };
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestStop = stop;
+			}
+		}
+
+		m_Ids.insert(std::begin(m_Ids) + bestStop, id);
+		m_Positions.insert(std::begin(m_Positions) + bestStop, position);
+		m_Report = true;
+		Restart();
+	}
+
+	void TourOptimizer::RemoveStop(int id)
+	{
+		const auto itId{ std::ranges::find(m_Ids, id) };
+		if (itId == std::end(m_Ids)) return;
+
+		m_Positions.erase(std::begin(m_Positions) + std::distance(std::begin(m_Ids), itId));
+		m_Ids.erase(itId);
+		m_Report = true;
+		Restart();
+	}
+
+	bool TourOptimizer::Contains(int id) const
+	{
+		return std::ranges::find(m_Ids, id) != std::end(m_Ids);
+	}
+
+	void TourOptimizer::Update(long long budget)
+	{
+		const auto start{ std::chrono::steady_clock::now() };
+
+		// One stop at a time, the tour is as good as these moves get it once a whole round of stops changed nothing
+		while (!IsOptimized())
+		{
+			if (m_NextStop >= m_Ids.size()) m_NextStop = 0;
+
+			if (ImproveStop(m_NextStop)) m_UnimprovedStops = 0;
+			else ++m_UnimprovedStops;
+			++m_NextStop;
+
+			if (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() >= budget) break;
+		}
+
+		if (m_Report && IsOptimized())
+		{
+			m_Report = false;
+
+			const float length{ GetLength() };
+			const float greedyLength{ GetGreedyLength() };
+			if (greedyLength > 0.0f) std::cout << "Tour of " << m_Ids.size() << " houses: " << length << " long, closest house first " << greedyLength << " (" << ((1.0f - (length / greedyLength)) * 100.0f) << "% shorter)" << std::endl;
+		}
+	}
+
+	int TourOptimizer::GetNextStop() const
+	{
+		return m_Ids.empty() ? InvalidId : m_Ids.front();
+	}
+
+	const std::vector<int>& TourOptimizer::GetOrder() const
+	{
+		return m_Ids;
+	}
+
+	float TourOptimizer::GetLength() const
+	{
+		float length{};
+		for (int stop{}; stop < int(m_Ids.size()); ++stop)
+		{
+			length += GetDistance(stop - 1, stop);
+		}
+
+		return length;
+	}
+
+	float TourOptimizer::GetGreedyLength() const
+	{
+		std::vector<bool> visited(m_Positions.size(), false);
+		Elite::Vector2 position{ m_Start };
+		float length{};
+
+		for (size_t step{}; step < m_Positions.size(); ++step)
+		{
+			size_t closest{};
+			float closestDistance{ FLT_MAX };
+			for (size_t stop{}; stop < m_Positions.size(); ++stop)
+			{
+				const float distance{ position.Distance(m_Positions[stop]) };
+				if (!visited[stop] && (distance < closestDistance))
+				{
+					closestDistance = distance;
+					closest = stop;
+				}
+			}
+
+			visited[closest] = true;
+			position = m_Positions[closest];
+			length += closestDistance;
+		}
+
+		return length;
+	}
+
+	bool TourOptimizer::IsOptimized() const
+	{
+		return m_UnimprovedStops >= m_Ids.size();
+	}
+
+	bool TourOptimizer::ImproveStop(size_t stop)
+	{
+		return TryTwoOpt(stop) || TryOrOpt(stop, 1) || TryOrOpt(stop, 2) || TryOrOpt(stop, 3);
+	}
+
+	bool TourOptimizer::TryTwoOpt(size_t first)
+	{
+		// Reversing the stops first to last swaps the edges before first and after last, the tour is open so there might be no edge after last
+		const int stopCount{ int(m_Ids.size()) };
+		const int i{ int(first) };
+		for (int j{ i + 1 }; j < stopCount; ++j)
+		{
+			const float gain{ GetDistance(i - 1, i) + GetDistance(j, j + 1) - GetDistance(i - 1, j) - GetDistance(i, j + 1) };
+			if (gain > MinimumGain)
+			{
+				std::reverse(std::begin(m_Ids) + i, std::begin(m_Ids) + j + 1);
+				std::reverse(std::begin(m_Positions) + i, std::begin(m_Positions) + j + 1);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool TourOptimizer::TryOrOpt(size_t first, size_t length)
+	{
+		// Move the stops first to last somewhere else in the tour, between stop and stop + 1
+		const int stopCount{ int(m_Ids.size()) };
+		const int i{ int(first) };
+		const int last{ i + int(length) - 1 };
+		if (last >= stopCount) return false;
+
+		const float removeGain{ GetDistance(i - 1, i) + GetDistance(last, last + 1) - ((last + 1 < stopCount) ? GetDistance(i - 1, last + 1) : 0.0f) };
+		for (int stop{ -1 }; stop < stopCount; ++stop)
+		{
+			if ((stop >= i - 1) && (stop <= last)) continue;
+
+			const float insertCost{ GetDistance(stop, i) + GetDistance(last, stop + 1) - GetDistance(stop, stop + 1) };
+			if ((removeGain - insertCost) > MinimumGain)
+			{
+				if (stop < i)
+				{
+					std::rotate(std::begin(m_Ids) + stop + 1, std::begin(m_Ids) + i, std::begin(m_Ids) + last + 1);
+					std::rotate(std::begin(m_Positions) + stop + 1, std::begin(m_Positions) + i, std::begin(m_Positions) + last + 1);
+				}
+				else
+				{
+					std::rotate(std::begin(m_Ids) + i, std::begin(m_Ids) + last + 1, std::begin(m_Ids) + stop + 1);
+					std::rotate(std::begin(m_Positions) + i, std::begin(m_Positions) + last + 1, std::begin(m_Positions) + stop + 1);
+				}
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void TourOptimizer::Restart()
+	{
+		m_UnimprovedStops = 0;
+	}
+
+	const Elite::Vector2& TourOptimizer::GetPoint(int stop) const
+	{
+		// Stop -1 is where we start from
+		return (stop < 0) ? m_Start : m_Positions[size_t(stop)];
+	}
+
+	float TourOptimizer::GetDistance(int from, int to) const
+	{
+		// Nothing comes after the last stop
+		if (to >= int(m_Ids.size())) return 0.0f;
+
+		return GetPoint(from).Distance(GetPoint(to));
+	}
+}
\ No newline at end of file
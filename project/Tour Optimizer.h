@@ -0,0 +1,61 @@
+#ifndef TOUR_OPTIMIZER
+#define TOUR_OPTIMIZER
+
+#include <vector>
+
+namespace Navigation
+{
+	// Order to visit a set of stops in, starting from our position, improved a little every frame with 2-opt and Or-opt moves
+	class TourOptimizer final
+	{
+	public:
+		static constexpr int InvalidId{ -1 };
+
+		explicit TourOptimizer(float restartDistance = 10.0f);
+		~TourOptimizer() = default;
+
+		TourOptimizer(const TourOptimizer&) = delete;
+		TourOptimizer& operator=(const TourOptimizer&) = delete;
+		TourOptimizer(TourOptimizer&&) = delete;
+		TourOptimizer& operator=(TourOptimizer&&) = delete;
+
+		// Moving further than the restart distance from the last start makes the tour worth improving again
+		void SetStart(const Elite::Vector2& start);
+		// New stops go where they make the tour the least longer
+		void AddStop(int id, const Elite::Vector2& position);
+		void RemoveStop(int id);
+		bool Contains(int id) const;
+
+		// Tries to improve the tour until it can't anymore or the budget in microseconds is used up
+		void Update(long long budget);
+
+		// InvalidId when there are no stops
+		int GetNextStop() const;
+		const std::vector<int>& GetOrder() const;
+		float GetLength() const;
+		// Length of the tour that always goes to the closest stop next
+		float GetGreedyLength() const;
+		bool IsOptimized() const;
+
+	private:
+		float m_RestartDistance;
+		Elite::Vector2 m_Start;
+		Elite::Vector2 m_OptimizedStart;
+		// The stops in visiting order
+		std::vector<int> m_Ids;
+		std::vector<Elite::Vector2> m_Positions;
+		// Where the next improvement pass continues and how many stops in a row couldn't be improved
+		size_t m_NextStop;
+		size_t m_UnimprovedStops;
+		bool m_Report;
+
+		bool ImproveStop(size_t stop);
+		bool TryTwoOpt(size_t first);
+		bool TryOrOpt(size_t first, size_t length);
+		void Restart();
+		const Elite::Vector2& GetPoint(int stop) const;
+		float GetDistance(int from, int to) const;
+	};
+}
+
+#endif
\ No newline at end of file
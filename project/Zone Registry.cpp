@@ -0,0 +1,199 @@
+#include "stdafx.h"
+#include "Zone Registry.h"
+
+namespace Memory
+{
+	ZoneRegistry::ZoneRegistry(float minimumLifeTime, float minimumTimeLeft) :
+		m_EstimatedLifeTime{ minimumLifeTime },
+		m_MinimumTimeLeft{ minimumTimeLeft },
+		m_Changed{ false },
+		m_Count{ 0 },
+		m_Zones{ Capacity * 2 },
+		m_ZoneHashes{},
+		m_CentersX{},
+		m_CentersY{},
+		m_Radii{},
+		m_Ages{}
+	{
+
+	}
+
+	void ZoneRegistry::Update(float deltaTime, std::span<const PurgeZoneInfo> sightings)
+	{
+		m_Changed = false;
+		for (size_t zone{}; zone < m_Count; ++zone)
+		{
+			m_Ages[zone] += deltaTime;
+		}
+
+		// New zones start their life now, a zone that is still there is older than we thought zones get
+		std::ranges::for_each(sightings, [this](const PurgeZoneInfo& sighting) -> void
+			{
+				const int* pZone{ m_Zones.Find(sighting.ZoneHash) };
+				const size_t zone{ (pZone != nullptr) ? size_t(*pZone) : AddZone(sighting) };
+				if ((pZone != nullptr) && (sighting.Radius > m_Radii[zone] + 0.01f)) m_Changed = true;
+
+				m_CentersX[zone] = sighting.Center.x;
+				m_CentersY[zone] = sighting.Center.y;
+				m_Radii[zone] = sighting.Radius;
+				m_EstimatedLifeTime = std::max(m_EstimatedLifeTime, m_Ages[zone] + m_MinimumTimeLeft);
+			});
+
+		// Forget the zones that should have ended
+		for (size_t zone{}; zone < m_Count;)
+		{
+			if (m_Ages[zone] > m_EstimatedLifeTime) RemoveZone(zone);
+			else ++zone;
+		}
+	}
+
+	bool ZoneRegistry::HasChanged() const
+	{
+		return m_Changed;
+	}
+
+	size_t ZoneRegistry::GetCount() const
+	{
+		return m_Count;
+	}
+
+	int ZoneRegistry::FindZone(int zoneHash) const
+	{
+		const int* pZone{ m_Zones.Find(zoneHash) };
+		return (pZone != nullptr) ? *pZone : -1;
+	}
+
+	int ZoneRegistry::GetZoneHash(size_t zone) const
+	{
+		return m_ZoneHashes[zone];
+	}
+
+	Elite::Vector2 ZoneRegistry::GetCenter(size_t zone) const
+	{
+		return Elite::Vector2{ m_CentersX[zone], m_CentersY[zone] };
+	}
+
+	float ZoneRegistry::GetRadius(size_t zone) const
+	{
+		return m_Radii[zone];
+	}
+
+	float ZoneRegistry::GetAge(size_t zone) const
+	{
+		return m_Ages[zone];
+	}
+
+	float ZoneRegistry::GetTimeLeft(size_t zone) const
+	{
+		return std::max(m_EstimatedLifeTime - m_Ages[zone], 0.0f);
+	}
+
+	float ZoneRegistry::GetEstimatedLifeTime() const
+	{
+		return m_EstimatedLifeTime;
+	}
+
+	bool ZoneRegistry::ContainsPoint(const Elite::Vector2& point, float margin) const
+	{
+		return FindContainingZone(point, margin) != -1;
+	}
+
+	int ZoneRegistry::FindContainingZone(const Elite::Vector2& point, float margin) const
+	{
+		for (size_t zone{}; zone < m_Count; ++zone)
+		{
+			const float offsetX{ point.x - m_CentersX[zone] };
+			const float offsetY{ point.y - m_CentersY[zone] };
+			const float radius{ m_Radii[zone] + margin };
+			if (((offsetX * offsetX) + (offsetY * offsetY)) < (radius * radius)) return int(zone);
+		}
+
+		return -1;
+	}
+
+	int ZoneRegistry::FindNearestZone(const Elite::Vector2& point) const
+	{
+		// Nearest to the edge of the zone, not to its center
+		int nearestZone{ -1 };
+		float nearestDistance{ FLT_MAX };
+		for (size_t zone{}; zone < m_Count; ++zone)
+		{
+			const float distance{ point.Distance(GetCenter(zone)) - m_Radii[zone] };
+			if (distance < nearestDistance)
+			{
+				nearestDistance = distance;
+				nearestZone = int(zone);
+			}
+		}
+
+		return nearestZone;
+	}
+
+	bool ZoneRegistry::IntersectsSegment(const Elite::Vector2& from, const Elite::Vector2& to, float margin) const
+	{
+		const float segmentX{ to.x - from.x };
+		const float segmentY{ to.y - from.y };
+		const float lengthSquared{ std::max((segmentX * segmentX) + (segmentY * segmentY), FLT_EPSILON) };
+
+		// Distance from every center to the closest point on the segment
+		for (size_t zone{}; zone < m_Count; ++zone)
+		{
+			const float offsetX{ m_CentersX[zone] - from.x };
+			const float offsetY{ m_CentersY[zone] - from.y };
+			const float t{ std::clamp(((offsetX * segmentX) + (offsetY * segmentY)) / lengthSquared, 0.0f, 1.0f) };
+			const float closestX{ offsetX - (segmentX * t) };
+			const float closestY{ offsetY - (segmentY * t) };
+			const float radius{ m_Radii[zone] + margin };
+			if (((closestX * closestX) + (closestY * closestY)) < (radius * radius)) return true;
+		}
+
+		return false;
+	}
+
+	int ZoneRegistry::FindFirstBlockedSegment(const std::vector<Elite::Vector2>& path, float margin) const
+	{
+		if (m_Count == 0) return -1;
+
+		for (size_t segment{ 1 }; segment < path.size(); ++segment)
+		{
+			if (IntersectsSegment(path[segment - 1], path[segment], margin)) return int(segment - 1);
+		}
+
+		return -1;
+	}
+
+	size_t ZoneRegistry::AddZone(const PurgeZoneInfo& zone)
+	{
+		// When we are full the oldest zone makes room, it is the first one to end
+		if (m_Count == Capacity)
+		{
+			RemoveZone(size_t(std::distance(std::begin(m_Ages), std::max_element(std::begin(m_Ages), std::end(m_Ages)))));
+		}
+
+		m_Changed = true;
+		const size_t index{ m_Count++ };
+		m_ZoneHashes[index] = zone.ZoneHash;
+		m_Ages[index] = 0.0f;
+		m_Zones.Insert(zone.ZoneHash, int(index));
+
+		return index;
+	}
+
+	void ZoneRegistry::RemoveZone(size_t zone)
+	{
+		// Move the last zone into the hole so the zones stay packed
+		m_Changed = true;
+		m_Zones.Erase(m_ZoneHashes[zone]);
+
+		const size_t last{ --m_Count };
+		if (zone == last) return;
+
+		m_ZoneHashes[zone] = m_ZoneHashes[last];
+		m_CentersX[zone] = m_CentersX[last];
+		m_CentersY[zone] = m_CentersY[last];
+		m_Radii[zone] = m_Radii[last];
+		m_Ages[zone] = m_Ages[last];
+
+		*m_Zones.Find(m_ZoneHashes[zone]) = int(zone);
+	}
+}
\ No newline at end of file
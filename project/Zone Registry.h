@@ -0,0 +1,71 @@
+#ifndef ZONE_REGISTRY
+#define ZONE_REGISTRY
+
+#include "Exam_HelperStructs.h"
+#include "Flat Hash Map.h"
+#include <array>
+#include <vector>
+#include <span>
+
+namespace Memory
+{
+	// Remembers the purge zones we saw by their hash until they should have ended, also after they left our field of view
+	class ZoneRegistry final
+	{
+	public:
+		static constexpr size_t Capacity{ 64 };
+
+		// Zones live at least the minimum life time, a zone we still see after that makes the estimate longer
+		// A zone we see always has at least the minimum time left, so it doesn't drop out of what relies on it and come back next frame
+		ZoneRegistry(float minimumLifeTime = 10.0f, float minimumTimeLeft = 1.0f);
+		~ZoneRegistry() = default;
+
+		ZoneRegistry(const ZoneRegistry&) = delete;
+		ZoneRegistry& operator=(const ZoneRegistry&) = delete;
+		ZoneRegistry(ZoneRegistry&&) = delete;
+		ZoneRegistry& operator=(ZoneRegistry&&) = delete;
+
+		// Ages the zones, stores this frame's sightings and forgets the zones that should have ended
+		void Update(float deltaTime, std::span<const PurgeZoneInfo> sightings);
+		// True when the last update added or removed a zone or a zone grew, the only times the grid needs to hear about them
+		bool HasChanged() const;
+
+		// Zones are indexed 0 to GetCount() - 1, indices change when zones expire
+		size_t GetCount() const;
+		int FindZone(int zoneHash) const;
+		int GetZoneHash(size_t zone) const;
+		Elite::Vector2 GetCenter(size_t zone) const;
+		float GetRadius(size_t zone) const;
+		// Seconds since we first saw it
+		float GetAge(size_t zone) const;
+		float GetTimeLeft(size_t zone) const;
+		float GetEstimatedLifeTime() const;
+
+		// Queries against every zone at once, the margin makes the zones that much bigger
+		bool ContainsPoint(const Elite::Vector2& point, float margin = 0.0f) const;
+		int FindContainingZone(const Elite::Vector2& point, float margin = 0.0f) const;
+		int FindNearestZone(const Elite::Vector2& point) const;
+		bool IntersectsSegment(const Elite::Vector2& from, const Elite::Vector2& to, float margin = 0.0f) const;
+		// Index of the first segment of the path that goes through a zone, -1 if the path is clear
+		int FindFirstBlockedSegment(const std::vector<Elite::Vector2>& path, float margin = 0.0f) const;
+
+	private:
+		float m_EstimatedLifeTime;
+		float m_MinimumTimeLeft;
+		bool m_Changed;
+		size_t m_Count;
+		Containers::FlatHashMap<int, int> m_Zones;
+
+		// One element per zone
+		std::array<int, Capacity> m_ZoneHashes;
+		std::array<float, Capacity> m_CentersX;
+		std::array<float, Capacity> m_CentersY;
+		std::array<float, Capacity> m_Radii;
+		std::array<float, Capacity> m_Ages;
+
+		size_t AddZone(const PurgeZoneInfo& zone);
+		void RemoveZone(size_t zone);
+	};
+}
+
+#endif
\ No newline at end of file